@@ -14,6 +14,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -180,6 +181,10 @@ namespace DirectX
         DDS_FLAGS_BAD_DXTN_TAILS        = 0x40,
             // Some older DXTn DDS files incorrectly handle mipchain tails for blocks smaller than 4x4
 
+        DDS_FLAGS_MAPPED_FILE           = 0x80,
+            // LoadFromDDSFile maps the file and returns images that point into the view instead of reading into new memory
+            // (the view is copy-on-write, so in-place edits never reach the file; legacy expansion still copies)
+
         DDS_FLAGS_FORCE_DX10_EXT        = 0x10000,
             // Always use the 'DX10' header extension for DDS writer (i.e. don't try to write DX9 compatible DDS files)
 
@@ -189,8 +194,15 @@ namespace DirectX
         DDS_FLAGS_FORCE_DX9_LEGACY      = 0x40000,
             // Force use of legacy header for DDS writer (will fail if unable to write as such)
 
+        DDS_FLAGS_WRITE_UNBUFFERED      = 0x80000,
+            // SaveToDDSFile bypasses the system file cache (FILE_FLAG_NO_BUFFERING), writing sector-aligned chunks
+
+        DDS_FLAGS_STRIPED_READ          = 0x100000,
+            // LoadFromDDSFile reads payloads of 256 MB or more as concurrent stripes, each through its own file handle
+
         DDS_FLAGS_ALLOW_LARGE_FILES     = 0x1000000,
             // Enables the loader to read large dimension .dds files (i.e. greater than known hardware requirements)
+            // and files of 4 GB or more (64-bit only)
     };
 
     enum TGA_FLAGS : unsigned long
@@ -305,6 +317,49 @@ namespace DirectX
         _In_z_ const wchar_t* szFile,
         _Out_ TexMetadata& metadata) noexcept;
 
+    // Bulk metadata
+    HRESULT __cdecl GetMetadataFromFiles(
+        _In_reads_(nfiles) const wchar_t* const* files, _In_ size_t nfiles,
+        _In_ DDS_FLAGS ddsFlags, _In_ TGA_FLAGS tgaFlags,
+        _Out_writes_(nfiles) TexMetadata* metadata, _Out_writes_(nfiles) HRESULT* results,
+        _In_opt_z_ const wchar_t* szCatalog = nullptr) noexcept;
+        // Reads only the headers of .dds, .tga, and .hdr files, scanning the list concurrently; results receives the
+        // status of each file. With szCatalog, files whose path, size, and last write time match a catalog entry are not
+        // opened, and the catalog is rewritten when anything new was read (entries for other paths are kept).
+        // Returns S_FALSE if the scan completed but the catalog could not be written.
+
+    //---------------------------------------------------------------------------------
+    // Memory allocation
+    class IAllocator
+    {
+    public:
+        virtual ~IAllocator() = default;
+
+        virtual void* __cdecl Allocate(_In_ size_t size, _In_ size_t alignment) noexcept = 0;
+        virtual void __cdecl Free(_In_ void* ptr, _In_ size_t size, _In_ size_t alignment) noexcept = 0;
+            // Free receives the size and alignment passed to Allocate; both may be called from multiple threads
+
+    protected:
+        IAllocator() = default;
+        IAllocator(const IAllocator&) = default;
+        IAllocator& operator=(const IAllocator&) = default;
+    };
+
+    IAllocator* __cdecl GetDefaultAllocator() noexcept;
+    IAllocator* __cdecl SetDefaultAllocator(_In_opt_ IAllocator* allocator) noexcept;
+        // Used by ScratchImage, Blob, and internal scratch buffers; nullptr restores the CRT aligned heap.
+        // Returns the previous allocator. An allocator must outlive every buffer it has handed out.
+
+    std::unique_ptr<IAllocator> __cdecl CreatePoolAllocator(_In_ size_t maxCachedBytes = 0) noexcept;
+        // Recycles freed blocks in power-of-two size classes, caching up to maxCachedBytes (0 for 256 MB)
+
+    std::unique_ptr<IAllocator> __cdecl CreateArenaAllocator(_In_ size_t blockSize = 0) noexcept;
+        // Bump allocates from blockSize chunks (0 for 64 MB); Free is a no-op and memory is returned when the arena is destroyed
+
+    std::unique_ptr<IAllocator> __cdecl CreateLargePageAllocator(_In_ size_t threshold = 0) noexcept;
+        // Requests of threshold bytes or more (0 for 2 MB) use large pages if the process holds SeLockMemoryPrivilege,
+        // otherwise page-granular VirtualAlloc memory; smaller requests use the CRT aligned heap
+
     //---------------------------------------------------------------------------------
     // Bitmap image container
     struct Image
@@ -321,9 +376,9 @@ namespace DirectX
     {
     public:
         ScratchImage() noexcept
-            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr) {}
+            : m_nimages(0), m_size(0), m_capacity(0), m_metadata{}, m_image(nullptr), m_memory(nullptr), m_allocator(nullptr), m_external(false), m_mappedView(nullptr) {}
         ScratchImage(ScratchImage&& moveFrom) noexcept
-            : m_nimages(0), m_size(0), m_metadata{}, m_image(nullptr), m_memory(nullptr) { *this = std::move(moveFrom); }
+            : m_nimages(0), m_size(0), m_capacity(0), m_metadata{}, m_image(nullptr), m_memory(nullptr), m_allocator(nullptr), m_external(false), m_mappedView(nullptr) { *this = std::move(moveFrom); }
         ~ScratchImage() { Release(); }
 
         ScratchImage& __cdecl operator= (ScratchImage&& moveFrom) noexcept;
@@ -343,8 +398,25 @@ namespace DirectX
         HRESULT __cdecl InitializeCubeFromImages(_In_reads_(nImages) const Image* images, _In_ size_t nImages, _In_ CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
         HRESULT __cdecl Initialize3DFromImages(_In_reads_(depth) const Image* images, _In_ size_t depth, _In_ CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
 
+        HRESULT __cdecl Attach(_In_ const TexMetadata& mdata, _In_reads_bytes_(size) void* pixels, _In_ size_t size, _In_ CP_FLAGS flags = CP_FLAGS_NONE) noexcept;
+            // Builds the image array over caller-owned memory without copying; mdata.mipLevels must be explicit.
+            // pixels must be 4-byte aligned, or 16-byte aligned for 128 bpp formats.
+            // The memory must stay valid until Release. A later Initialize whose layout fits writes into it rather than allocating.
+
+        HRESULT __cdecl AttachMappedView(_In_ const TexMetadata& mdata, _In_ void* view, _In_ size_t offset, _In_ size_t size) noexcept;
+            // Attach to the pixels at offset within a MapViewOfFile view of size bytes, taking ownership of the view.
+            // The view must be writable (FILE_MAP_COPY) since in-place operations write to the pixels; it is unmapped on Release.
+            // A mapped view reports no capacity so it is never reused for output.
+
+        bool __cdecl IsAttached() const noexcept { return m_external; }
+
         void __cdecl Release() noexcept;
 
+        void __cdecl Recycle() noexcept;
+            // Drops the images but keeps the pixel allocation; Initialize reuses it when the new layout fits
+
+        void __cdecl Swap(_Inout_ ScratchImage& other) noexcept;
+
         bool __cdecl OverrideFormat(_In_ DXGI_FORMAT f) noexcept;
 
         const TexMetadata& __cdecl GetMetadata() const noexcept { return m_metadata; }
@@ -353,17 +425,29 @@ namespace DirectX
         const Image* __cdecl GetImages() const noexcept { return m_image; }
         size_t __cdecl GetImageCount() const noexcept { return m_nimages; }
 
-        uint8_t* __cdecl GetPixels() const noexcept { return m_memory; }
+        uint8_t* __cdecl GetPixels() const noexcept { return (m_size) ? m_memory : nullptr; }
         size_t __cdecl GetPixelsSize() const noexcept { return m_size; }
+        size_t __cdecl GetPixelsCapacity() const noexcept { return m_capacity; }
 
         bool __cdecl IsAlphaAllOpaque() const noexcept;
 
+        IAllocator* __cdecl GetAllocator() const noexcept { return m_allocator; }
+        void __cdecl SetAllocator(_In_opt_ IAllocator* allocator) noexcept { m_allocator = allocator; }
+            // Applies to the next Initialize that needs more capacity; nullptr uses the default allocator
+
     private:
         size_t      m_nimages;
         size_t      m_size;
+        size_t      m_capacity;
         TexMetadata m_metadata;
         Image*      m_image;
         uint8_t*    m_memory;
+        IAllocator* m_allocator;
+        bool        m_external;
+        void*       m_mappedView;
+
+        bool __cdecl Reserve(_In_ size_t pixelSize) noexcept;
+        void __cdecl FreeMemory() noexcept;
     };
 
     //---------------------------------------------------------------------------------
@@ -371,8 +455,8 @@ namespace DirectX
     class Blob
     {
     public:
-        Blob() noexcept : m_buffer(nullptr), m_size(0) {}
-        Blob(Blob&& moveFrom) noexcept : m_buffer(nullptr), m_size(0) { *this = std::move(moveFrom); }
+        Blob() noexcept : m_buffer(nullptr), m_size(0), m_allocator(nullptr) {}
+        Blob(Blob&& moveFrom) noexcept : m_buffer(nullptr), m_size(0), m_allocator(nullptr) { *this = std::move(moveFrom); }
         ~Blob() { Release(); }
 
         Blob& __cdecl operator= (Blob&& moveFrom) noexcept;
@@ -389,9 +473,14 @@ namespace DirectX
 
         HRESULT __cdecl Trim(size_t size) noexcept;
 
+        IAllocator* __cdecl GetAllocator() const noexcept { return m_allocator; }
+        void __cdecl SetAllocator(_In_opt_ IAllocator* allocator) noexcept { m_allocator = allocator; }
+            // Applies to the next Initialize; nullptr uses the default allocator
+
     private:
-        void*   m_buffer;
-        size_t  m_size;
+        void*       m_buffer;
+        size_t      m_size;
+        IAllocator* m_allocator;
     };
 
     //---------------------------------------------------------------------------------
@@ -407,6 +496,20 @@ namespace DirectX
         _In_ DDS_FLAGS flags,
         _Out_opt_ TexMetadata* metadata, _Out_ ScratchImage& image) noexcept;
 
+    HRESULT __cdecl LoadFromDDSMemory(
+        _In_reads_bytes_(size) const void* pSource, _In_ size_t size,
+        _In_ DDS_FLAGS flags,
+        _In_ size_t mipStart, _In_ size_t mipCount, _In_ size_t itemStart, _In_ size_t itemCount,
+        _Out_opt_ TexMetadata* metadata, _Out_ ScratchImage& image) noexcept;
+    HRESULT __cdecl LoadFromDDSFile(
+        _In_z_ const wchar_t* szFile,
+        _In_ DDS_FLAGS flags,
+        _In_ size_t mipStart, _In_ size_t mipCount, _In_ size_t itemStart, _In_ size_t itemCount,
+        _Out_opt_ TexMetadata* metadata, _Out_ ScratchImage& image) noexcept;
+        // Loads only mips [mipStart, mipStart + mipCount) of items [itemStart, itemStart + itemCount), where a count of 0
+        // means the rest; items are array slices or cube faces. Only those subresources are read from the file, and
+        // metadata describes the returned subset (a partial set of cube faces becomes a 2D array).
+
     HRESULT __cdecl SaveToDDSMemory(
         _In_ const Image& image,
         _In_ DDS_FLAGS flags,
@@ -421,6 +524,40 @@ namespace DirectX
         _In_reads_(nimages) const Image* images, _In_ size_t nimages, _In_ const TexMetadata& metadata,
         _In_ DDS_FLAGS flags, _In_z_ const wchar_t* szFile) noexcept;
 
+    // Streaming DDS writer (only the subresource being written needs to be resident)
+    class DDSFileWriter
+    {
+    public:
+        DDSFileWriter() noexcept;
+        DDSFileWriter(DDSFileWriter&& moveFrom) noexcept;
+        ~DDSFileWriter();
+
+        DDSFileWriter& __cdecl operator= (DDSFileWriter&& moveFrom) noexcept;
+
+        DDSFileWriter(const DDSFileWriter&) = delete;
+        DDSFileWriter& operator=(const DDSFileWriter&) = delete;
+
+        HRESULT __cdecl Create(_In_z_ const wchar_t* szFile, _In_ const TexMetadata& metadata, _In_ DDS_FLAGS flags = DDS_FLAGS_NONE) noexcept;
+            // Creates the file and writes the header for metadata (which must give an explicit mipLevels)
+
+        HRESULT __cdecl WriteImage(_In_ const Image& image) noexcept;
+        HRESULT __cdecl WriteImages(_In_reads_(nimages) const Image* images, _In_ size_t nimages) noexcept;
+            // Appends the next subresources in file order: all mips of each item for 1D/2D, all slices of each mip for 3D
+
+        HRESULT __cdecl Commit() noexcept;
+            // Fails unless every subresource has been written; a file which is released before Commit is deleted
+
+        void __cdecl Release() noexcept;
+
+        const TexMetadata& __cdecl GetMetadata() const noexcept;
+        size_t __cdecl GetImageCount() const noexcept;
+        size_t __cdecl GetImagesWritten() const noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+
     // HDR operations
     HRESULT __cdecl LoadFromHDRMemory(
         _In_reads_bytes_(size) const void* pSource, _In_ size_t size,
@@ -530,6 +667,10 @@ namespace DirectX
         TEX_FILTER_FLOAT_X2BIAS     = 0x200,
             // Enable *2 - 1 conversion cases for unorm<->float and positive-only float formats
 
+        TEX_FILTER_FLOAT_MIPS       = 0x400,
+            // For box and linear mipmap generation, filter each level from a float copy of the previous level
+            // instead of reloading its converted result, so only the output is quantized
+
         TEX_FILTER_RGB_COPY_RED     = 0x1000,
         TEX_FILTER_RGB_COPY_GREEN   = 0x2000,
         TEX_FILTER_RGB_COPY_BLUE    = 0x4000,
@@ -547,7 +688,11 @@ namespace DirectX
         TEX_FILTER_BOX              = 0x400000,
         TEX_FILTER_FANT             = 0x400000, // Equiv to Box filtering for mipmap generation
         TEX_FILTER_TRIANGLE         = 0x500000,
+        TEX_FILTER_LANCZOS          = 0x600000,
+        TEX_FILTER_MITCHELL         = 0x700000,
+        TEX_FILTER_KAISER           = 0x800000,
             // Filtering mode to use for any required image resizing
+            // LANCZOS, MITCHELL, and KAISER are supported by Resize and GenerateMipMaps, but not GenerateMipMaps3D
 
         TEX_FILTER_SRGB_IN          = 0x1000000,
         TEX_FILTER_SRGB_OUT         = 0x2000000,
@@ -577,6 +722,13 @@ namespace DirectX
         // Resize the image to width x height. Defaults to Fant filtering.
         // Note for a complex resize, the result will always have mipLevels == 1
 
+    HRESULT __cdecl Resize(
+        _In_ const Image& srcImage,
+        _In_reads_(count) const size_t* widths, _In_reads_(count) const size_t* heights, _In_ size_t count,
+        _In_ TEX_FILTER_FLAGS filter, _Out_writes_(count) ScratchImage* images) noexcept;
+        // Resize the image to several sizes, decoding the source only once. Defaults to Box (area) filtering.
+        // BOX, TRIANGLE, LANCZOS, MITCHELL, and KAISER share a single pass; other filters resize to each size in turn
+
     const float TEX_THRESHOLD_DEFAULT = 0.5f;
         // Default value for alpha threshold used when converting to 1-bit alpha
 
@@ -588,12 +740,43 @@ namespace DirectX
         _In_ DXGI_FORMAT format, _In_ TEX_FILTER_FLAGS filter, _In_ float threshold, _Out_ ScratchImage& result) noexcept;
         // Convert the image to a new format
 
+    HRESULT __cdecl ConvertInPlace(
+        _Inout_ ScratchImage& image, _In_ DXGI_FORMAT format, _In_ TEX_FILTER_FLAGS filter, _In_ float threshold) noexcept;
+        // Convert all images in the container to a new format, rewriting the existing pixel memory when both formats
+        // have the same bits-per-pixel (non-WIC code paths only). Otherwise falls back to allocating a new container.
+        // On failure the container is released.
+
     HRESULT __cdecl ConvertToSinglePlane(_In_ const Image& srcImage, _Out_ ScratchImage& image) noexcept;
     HRESULT __cdecl ConvertToSinglePlane(
         _In_reads_(nimages) const Image* srcImages, _In_ size_t nimages, _In_ const TexMetadata& metadata,
         _Out_ ScratchImage& image) noexcept;
         // Converts the image from a planar format to an equivalent non-planar format
 
+    enum TEX_YUV_FLAGS : unsigned long
+    {
+        TEX_YUV_DEFAULT             = 0,
+
+        TEX_YUV_BT601               = 0x0,
+        TEX_YUV_BT709               = 0x1,
+        TEX_YUV_BT2020              = 0x2,
+            // Y'CbCr to R'G'B' color matrix (defaults to BT.601)
+
+        TEX_YUV_FULL_RANGE          = 0x10,
+            // Source uses the full code range rather than the limited 'studio' range (i.e. 16-235 luma, 16-240 chroma for 8-bit)
+    };
+
+    constexpr unsigned long TEX_YUV_MATRIX_MASK = 0xF;
+
+    HRESULT __cdecl ConvertFromYUV(
+        _In_ const Image& srcImage, _In_ DXGI_FORMAT format, _In_ TEX_YUV_FLAGS flags,
+        _Out_ ScratchImage& image) noexcept;
+    HRESULT __cdecl ConvertFromYUV(
+        _In_reads_(nimages) const Image* srcImages, _In_ size_t nimages, _In_ const TexMetadata& metadata,
+        _In_ DXGI_FORMAT format, _In_ TEX_YUV_FLAGS flags, _Out_ ScratchImage& result) noexcept;
+        // Converts planar (NV12, P010, P016, NV11) or packed (AYUV, Y410, Y416, YUY2, Y210, Y216) video formats
+        // directly to an RGB format such as DXGI_FORMAT_R8G8B8A8_UNORM or DXGI_FORMAT_R16G16B16A16_FLOAT.
+        // Chroma is replicated (nearest) for subsampled formats
+
     HRESULT __cdecl GenerateMipMaps(
         _In_ const Image& baseImage, _In_ TEX_FILTER_FLAGS filter, _In_ size_t levels,
         _Inout_ ScratchImage& mipChain, _In_ bool allow1D = false) noexcept;
@@ -603,14 +786,30 @@ namespace DirectX
         // levels of '0' indicates a full mipchain, otherwise is generates that number of total levels (including the source base image)
         // Defaults to Fant filtering which is equivalent to a box filter
 
+    struct Rect;
+
+    HRESULT __cdecl UpdateMipMaps(
+        _In_reads_(nrects) const Rect* dirtyRects, _In_ size_t nrects, _In_ TEX_FILTER_FLAGS filter, _In_ size_t item,
+        _Inout_ ScratchImage& mipChain) noexcept;
+        // Regenerates only the parts of mip levels 1 and below of the given 1D/2D item that depend on dirtyRects in its top level
+        // Results match GenerateMipMaps with the same custom filter (TEX_FILTER_FORCE_NON_WIC); WIC and TEX_FILTER_FLOAT_MIPS are not supported
+
     HRESULT __cdecl GenerateMipMaps3D(
         _In_reads_(depth) const Image* baseImages, _In_ size_t depth, _In_ TEX_FILTER_FLAGS filter, _In_ size_t levels,
         _Out_ ScratchImage& mipChain) noexcept;
     HRESULT __cdecl GenerateMipMaps3D(
         _In_reads_(nimages) const Image* srcImages, _In_ size_t nimages, _In_ const TexMetadata& metadata,
         _In_ TEX_FILTER_FLAGS filter, _In_ size_t levels, _Out_ ScratchImage& mipChain);
+    HRESULT __cdecl GenerateMipMaps3D(
+        _In_reads_(depth) const Image* baseImages, _In_ size_t depth, _In_ TEX_FILTER_FLAGS filter, _In_ size_t levels,
+        _In_ size_t scratchBudget, _Out_ ScratchImage& mipChain) noexcept;
+    HRESULT __cdecl GenerateMipMaps3D(
+        _In_reads_(nimages) const Image* srcImages, _In_ size_t nimages, _In_ const TexMetadata& metadata,
+        _In_ TEX_FILTER_FLAGS filter, _In_ size_t levels, _In_ size_t scratchBudget, _Out_ ScratchImage& mipChain);
         // levels of '0' indicates a full mipchain, otherwise is generates that number of total levels (including the source base image)
         // Defaults to Fant filtering which is equivalent to a box filter
+        // scratchBudget caps the temporary bytes used beyond the output mipchain (0 is unlimited); fewer slices are
+        // filtered in parallel to stay within it, and ERROR_NOT_ENOUGH_MEMORY is returned if a single slice won't fit
 
     HRESULT __cdecl ScaleMipMapsAlphaForCoverage(
         _In_reads_(nimages) const Image* srcImages, _In_ size_t nimages, _In_ const TexMetadata& metadata, _In_ size_t item,
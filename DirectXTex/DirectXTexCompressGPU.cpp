@@ -59,7 +59,7 @@ namespace
             return E_POINTER;
         }
 
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR) * srcImage.width), 16)));
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR) * srcImage.width), 16)));
         if (!scanline)
         {
             image.Release();
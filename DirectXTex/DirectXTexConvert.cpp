@@ -11,6 +11,11 @@
 
 #include "DirectXTexP.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#pragma warning(disable : 4616 6993)
+#endif
+
 using namespace DirectX;
 using namespace DirectX::PackedVector;
 using Microsoft::WRL::ComPtr;
@@ -192,6 +197,351 @@ namespace
     const XMVECTORF32 g_HalfMin   = { { { -65504.f, -65504.f, -65504.f, -65504.f } } };
     const XMVECTORF32 g_HalfMax   = { { { 65504.f, 65504.f, 65504.f, 65504.f } } };
     const XMVECTORF32 g_8BitBias  = { { { 0.5f / 255.f, 0.5f / 255.f, 0.5f / 255.f, 0.5f / 255.f } } };
+
+    //-------------------------------------------------------------------------------------
+    // Bulk R11G11B10_FLOAT and R9G9B9E5_SHAREDEXP encoders & decoders
+    //
+    // Results are bit-exact with XMStoreFloat3PK/XMLoadFloat3PK and StoreFloat3SE/XMLoadFloat3SE.
+    // Four pixels at a time are transposed to one register per channel and processed with SSE2
+    // integer operations. Groups that contain INF, NaN, or values which encode as float11/float10
+    // denormals are rare, so they are handed to the scalar functions instead.
+    //-------------------------------------------------------------------------------------
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+    template<uint32_t SHIFT, uint32_t MINI, uint32_t MAXI, uint32_t MAXR, uint32_t MASK>
+    inline bool XM_CALLCONV EncodeFloatPK4(__m128 v, __m128i& result) noexcept
+    {
+        const __m128i bits = _mm_castps_si128(v);
+        const __m128i sign = _mm_srai_epi32(bits, 31);
+        const __m128i I = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+        const __m128i infnan = _mm_cmpgt_epi32(I, _mm_set1_epi32(0x7F7FFFFF));
+        const __m128i denorm = _mm_andnot_si128(sign,
+            _mm_and_si128(_mm_cmpgt_epi32(I, _mm_set1_epi32(static_cast<int>(MINI - 1))), _mm_cmplt_epi32(I, _mm_set1_epi32(0x38800000))));
+        if (_mm_movemask_epi8(_mm_or_si128(infnan, denorm)))
+            return false;
+
+        // Rebias the exponent and round to nearest even
+        __m128i t = _mm_add_epi32(I, _mm_set1_epi32(static_cast<int>(0xC8000000u)));
+        t = _mm_add_epi32(t, _mm_add_epi32(_mm_set1_epi32((1 << (SHIFT - 1)) - 1), _mm_and_si128(_mm_srli_epi32(t, SHIFT), _mm_set1_epi32(1))));
+        t = _mm_and_si128(_mm_srli_epi32(t, SHIFT), _mm_set1_epi32(static_cast<int>(MASK)));
+
+        // Clamp large values to the max finite value, and flush negative or tiny values to zero
+        const __m128i big = _mm_cmpgt_epi32(I, _mm_set1_epi32(static_cast<int>(MAXI)));
+        t = _mm_or_si128(_mm_andnot_si128(big, t), _mm_and_si128(big, _mm_set1_epi32(static_cast<int>(MAXR))));
+
+        const __m128i zero = _mm_or_si128(sign, _mm_cmplt_epi32(I, _mm_set1_epi32(static_cast<int>(MINI))));
+        result = _mm_andnot_si128(zero, t);
+        return true;
+    }
+
+    template<uint32_t MBITS>
+    inline __m128 XM_CALLCONV DecodeFloatPK4(__m128i v, float denormScale) noexcept
+    {
+        const __m128i e = _mm_srli_epi32(v, MBITS);
+        const __m128i m = _mm_and_si128(v, _mm_set1_epi32((1 << MBITS) - 1));
+
+        const __m128i normal = _mm_add_epi32(_mm_slli_epi32(v, 23 - MBITS), _mm_set1_epi32(112 << 23));
+        const __m128i infnan = _mm_or_si128(_mm_slli_epi32(m, 23 - MBITS), _mm_set1_epi32(0x7F800000));
+        const __m128i denorm = _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(m), _mm_set1_ps(denormScale)));
+
+        const __m128i isDenorm = _mm_cmpeq_epi32(e, _mm_setzero_si128());
+        const __m128i isInfNaN = _mm_cmpeq_epi32(e, _mm_set1_epi32(0x1F));
+
+        __m128i result = _mm_or_si128(_mm_andnot_si128(isDenorm, normal), _mm_and_si128(isDenorm, denorm));
+        result = _mm_or_si128(_mm_andnot_si128(isInfNaN, result), _mm_and_si128(isInfNaN, infnan));
+        return _mm_castsi128_ps(result);
+    }
+
+    // Rounds the shared-exponent mantissas the same way as StoreFloat3SE
+    inline __m128i XM_CALLCONV RoundMantissa4(__m128 v) noexcept
+    {
+#if DIRECTX_MATH_VERSION >= 310
+        // XMStoreFloat3SE rounds half to even, as does the default MXCSR rounding mode
+        return _mm_cvtps_epi32(v);
+#else
+        // The local StoreFloat3SE uses lroundf (half away from zero); values are non-negative
+        const __m128i t = _mm_cvttps_epi32(v);
+        const __m128 frac = _mm_sub_ps(v, _mm_cvtepi32_ps(t));
+        return _mm_sub_epi32(t, _mm_castps_si128(_mm_cmpge_ps(frac, _mm_set1_ps(0.5f))));
+#endif
+    }
+#endif
+
+    void StoreFloat3PKStream(
+        _Out_writes_(count) XMFLOAT3PK* pDestination,
+        _In_reads_(count) const XMVECTOR* pSource,
+        size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+        for (; (i + 4) <= count; i += 4)
+        {
+            XMVECTOR r = pSource[i];
+            XMVECTOR g = pSource[i + 1];
+            XMVECTOR b = pSource[i + 2];
+            XMVECTOR a = pSource[i + 3];
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+
+            __m128i x, y, z;
+            if (EncodeFloatPK4<17, 0x35800000, 0x477E0000, 0x7BF, 0x7FF>(r, x)
+                && EncodeFloatPK4<17, 0x35800000, 0x477E0000, 0x7BF, 0x7FF>(g, y)
+                && EncodeFloatPK4<18, 0x36000000, 0x477C0000, 0x3DF, 0x3FF>(b, z))
+            {
+                __m128i v = _mm_or_si128(x, _mm_or_si128(_mm_slli_epi32(y, 11), _mm_slli_epi32(z, 22)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), v);
+            }
+            else
+            {
+                for (size_t j = i; j < (i + 4); ++j)
+                {
+                    XMStoreFloat3PK(pDestination + j, pSource[j]);
+                }
+            }
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            XMStoreFloat3PK(pDestination + i, pSource[i]);
+        }
+    }
+
+    void LoadFloat3PKStream(
+        _Out_writes_(count) XMVECTOR* pDestination,
+        _In_reads_(count) const XMFLOAT3PK* pSource,
+        size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+        for (; (i + 4) <= count; i += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i));
+
+            XMVECTOR x = DecodeFloatPK4<6>(_mm_and_si128(v, _mm_set1_epi32(0x7FF)), 1.f / 1048576.f);
+            XMVECTOR y = DecodeFloatPK4<6>(_mm_and_si128(_mm_srli_epi32(v, 11), _mm_set1_epi32(0x7FF)), 1.f / 1048576.f);
+            XMVECTOR z = DecodeFloatPK4<5>(_mm_srli_epi32(v, 22), 1.f / 524288.f);
+            XMVECTOR w = g_XMOne;
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            pDestination[i] = x;
+            pDestination[i + 1] = y;
+            pDestination[i + 2] = z;
+            pDestination[i + 3] = w;
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            XMVECTOR v = XMLoadFloat3PK(pSource + i);
+            pDestination[i] = XMVectorSelect(g_XMIdentityR3, v, g_XMSelect1110);
+        }
+    }
+
+    void StoreFloat3SEStream(
+        _Out_writes_(count) XMFLOAT3SE* pDestination,
+        _In_reads_(count) const XMVECTOR* pSource,
+        size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+        const __m128 maxf9 = _mm_set1_ps(float(0x1FF << 7));
+        const __m128 minf9 = _mm_set1_ps(float(1.f / (1 << 16)));
+        const __m128 zero = _mm_setzero_ps();
+
+        for (; (i + 4) <= count; i += 4)
+        {
+            XMVECTOR r = pSource[i];
+            XMVECTOR g = pSource[i + 1];
+            XMVECTOR b = pSource[i + 2];
+            XMVECTOR a = pSource[i + 3];
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+
+            // Clamp to [0, maxf9] with NaN going to zero
+            const __m128 x = _mm_and_ps(_mm_cmpge_ps(r, zero), _mm_min_ps(r, maxf9));
+            const __m128 y = _mm_and_ps(_mm_cmpge_ps(g, zero), _mm_min_ps(g, maxf9));
+            const __m128 z = _mm_and_ps(_mm_cmpge_ps(b, zero), _mm_min_ps(b, maxf9));
+
+            const __m128 maxColor = _mm_max_ps(_mm_max_ps(_mm_max_ps(x, y), z), minf9);
+
+            // Round up leaving 9 bits in fraction (including assumed 1)
+            const __m128i exp = _mm_srli_epi32(_mm_add_epi32(_mm_castps_si128(maxColor), _mm_set1_epi32(0x4000)), 23);
+            const __m128i e = _mm_and_si128(_mm_sub_epi32(exp, _mm_set1_epi32(0x6f)), _mm_set1_epi32(0x1F));
+
+            const __m128 scaleR = _mm_castsi128_ps(_mm_sub_epi32(_mm_set1_epi32(static_cast<int>(0x83000000u)), _mm_slli_epi32(exp, 23)));
+
+            const __m128i mask9 = _mm_set1_epi32(0x1FF);
+            const __m128i xm = _mm_and_si128(RoundMantissa4(_mm_mul_ps(x, scaleR)), mask9);
+            const __m128i ym = _mm_and_si128(RoundMantissa4(_mm_mul_ps(y, scaleR)), mask9);
+            const __m128i zm = _mm_and_si128(RoundMantissa4(_mm_mul_ps(z, scaleR)), mask9);
+
+            __m128i v = _mm_or_si128(_mm_or_si128(xm, _mm_slli_epi32(ym, 9)), _mm_or_si128(_mm_slli_epi32(zm, 18), _mm_slli_epi32(e, 27)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), v);
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            StoreFloat3SE(pDestination + i, pSource[i]);
+        }
+    }
+
+    void LoadFloat3SEStream(
+        _Out_writes_(count) XMVECTOR* pDestination,
+        _In_reads_(count) const XMFLOAT3SE* pSource,
+        size_t count) noexcept
+    {
+        size_t i = 0;
+
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+        for (; (i + 4) <= count; i += 4)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i));
+
+            const __m128i mask9 = _mm_set1_epi32(0x1FF);
+            const __m128 scale = _mm_castsi128_ps(_mm_add_epi32(_mm_set1_epi32(0x33800000), _mm_slli_epi32(_mm_srli_epi32(v, 27), 23)));
+
+            XMVECTOR x = _mm_mul_ps(scale, _mm_cvtepi32_ps(_mm_and_si128(v, mask9)));
+            XMVECTOR y = _mm_mul_ps(scale, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 9), mask9)));
+            XMVECTOR z = _mm_mul_ps(scale, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(v, 18), mask9)));
+            XMVECTOR w = g_XMOne;
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            pDestination[i] = x;
+            pDestination[i + 1] = y;
+            pDestination[i + 2] = z;
+            pDestination[i + 3] = w;
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            XMVECTOR v = XMLoadFloat3SE(pSource + i);
+            pDestination[i] = XMVectorSelect(g_XMIdentityR3, v, g_XMSelect1110);
+        }
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Half-float conversion
+    //
+    // With F16C (/arch:AVX2) the hardware conversion instructions are used directly,
+    // otherwise these SSE2 versions match XMConvertHalfToFloat/XMConvertFloatToHalf
+    // for four values held in the low 16 bits of each 32-bit lane.
+    //-------------------------------------------------------------------------------------
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_) && !defined(_XM_F16C_INTRINSICS_)
+    inline __m128 XM_CALLCONV HalfToFloat4(__m128i h) noexcept
+    {
+        const __m128i expmant = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7FFF)), 13);
+        const __m128i exponent = _mm_and_si128(expmant, _mm_set1_epi32(0x0F800000));
+
+        // Rebias the exponent; INF/NaN get the maximum exponent
+        __m128i o = _mm_add_epi32(expmant, _mm_set1_epi32((127 - 15) << 23));
+        const __m128i infnan = _mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x0F800000));
+        o = _mm_add_epi32(o, _mm_and_si128(infnan, _mm_set1_epi32((128 - 16) << 23)));
+
+        // Denormals are renormalized by subtracting the implicit leading one
+        const __m128i denorm = _mm_cmpeq_epi32(exponent, _mm_setzero_si128());
+        const __m128 magic = _mm_castsi128_ps(_mm_set1_epi32(113 << 23));
+        const __m128 d = _mm_sub_ps(_mm_castsi128_ps(_mm_add_epi32(o, _mm_set1_epi32(1 << 23))), magic);
+        o = _mm_or_si128(_mm_andnot_si128(denorm, o), _mm_and_si128(denorm, _mm_castps_si128(d)));
+
+        const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+        return _mm_castsi128_ps(_mm_or_si128(o, sign));
+    }
+
+    inline __m128i XM_CALLCONV FloatToHalf4(__m128 v) noexcept
+    {
+        const __m128i bits = _mm_castps_si128(v);
+        const __m128i sign = _mm_srli_epi32(_mm_and_si128(bits, _mm_set1_epi32(static_cast<int>(0x80000000u))), 16);
+        const __m128i f = _mm_and_si128(bits, _mm_set1_epi32(0x7FFFFFFF));
+
+        // Too large to be represented as a half: INF, or NaN with the payload preserved
+        const __m128i nan = _mm_cmpgt_epi32(f, _mm_set1_epi32(0x7F800000));
+        const __m128i nanbits = _mm_or_si128(_mm_set1_epi32(0x200), _mm_and_si128(_mm_srli_epi32(f, 13), _mm_set1_epi32(0x3FF)));
+        const __m128i inf = _mm_or_si128(_mm_set1_epi32(0x7C00), _mm_and_si128(nan, nanbits));
+
+        // Denormalized halves use the FPU to round to nearest even
+        const __m128 denormMagic = _mm_castsi128_ps(_mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23));
+        const __m128i denorm = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(f), denormMagic)), _mm_castps_si128(denormMagic));
+
+        // Normalized halves rebias the exponent and round to nearest even
+        __m128i normal = _mm_add_epi32(f, _mm_set1_epi32(((15 - 127) << 23) + 0xFFF));
+        normal = _mm_add_epi32(normal, _mm_and_si128(_mm_srli_epi32(f, 13), _mm_set1_epi32(1)));
+        normal = _mm_srli_epi32(normal, 13);
+
+        const __m128i isInf = _mm_cmpgt_epi32(f, _mm_set1_epi32(((127 + 16) << 23) - 1));
+        const __m128i isDenorm = _mm_cmplt_epi32(f, _mm_set1_epi32(113 << 23));
+
+        __m128i o = _mm_or_si128(_mm_andnot_si128(isDenorm, normal), _mm_and_si128(isDenorm, denorm));
+        o = _mm_or_si128(_mm_andnot_si128(isInf, o), _mm_and_si128(isInf, inf));
+        return _mm_or_si128(o, sign);
+    }
+#endif
+
+    constexpr size_t HALF_CHUNK_PIXELS = 64;
+        // Pixels converted per pass through the stack buffers used for 16-bit float scanlines
+
+    void LoadHalfScanline(
+        _Out_writes_(count) XMVECTOR* pDestination,
+        _In_reads_(count * channels) const uint16_t* pSource,
+        size_t count,
+        size_t channels) noexcept
+    {
+        if (channels == 4)
+        {
+            _ConvertHalfToFloatStream(reinterpret_cast<float*>(pDestination), pSource, count * 4);
+            return;
+        }
+
+        float tmp[HALF_CHUNK_PIXELS * 2];
+        for (size_t i = 0; i < count; i += HALF_CHUNK_PIXELS)
+        {
+            const size_t n = std::min(HALF_CHUNK_PIXELS, count - i);
+            _ConvertHalfToFloatStream(tmp, pSource + i * channels, n * channels);
+
+            const float* f = tmp;
+            for (size_t j = 0; j < n; ++j, f += channels)
+            {
+                pDestination[i + j] = XMVectorSet(f[0], (channels > 1) ? f[1] : 0.f, 0.f, 1.f);
+            }
+        }
+    }
+
+    void StoreHalfScanline(
+        _Out_writes_(count * channels) uint16_t* pDestination,
+        _In_reads_(count) const XMVECTOR* pSource,
+        size_t count,
+        size_t channels) noexcept
+    {
+        XM_ALIGNED_DATA(16) float tmp[HALF_CHUNK_PIXELS * 4];
+        for (size_t i = 0; i < count; i += HALF_CHUNK_PIXELS)
+        {
+            const size_t n = std::min(HALF_CHUNK_PIXELS, count - i);
+
+            float* f = tmp;
+            for (size_t j = 0; j < n; ++j, f += channels)
+            {
+                switch (channels)
+                {
+                case 4:
+                    XMStoreFloat4A(reinterpret_cast<XMFLOAT4A*>(f), XMVectorClamp(pSource[i + j], g_HalfMin, g_HalfMax));
+                    break;
+
+                case 2:
+                    XMStoreFloat2(reinterpret_cast<XMFLOAT2*>(f), XMVectorClamp(pSource[i + j], g_HalfMin, g_HalfMax));
+                    break;
+
+                default:
+                    *f = std::max<float>(std::min<float>(XMVectorGetX(pSource[i + j]), 65504.f), -65504.f);
+                    break;
+                }
+            }
+
+            _ConvertFloatToHalfStream(pDestination + i * channels, tmp, n * channels);
+        }
+    }
 }
 
 //-------------------------------------------------------------------------------------
@@ -645,7 +995,7 @@ bool DirectX::_ExpandScanline(
                 uint16_t t = *(sPtr++);
 
                 uint32_t t1 = uint32_t(((t & 0xf800) >> 8) | ((t & 0xe000) >> 13));
-                uint32_t t2 = uint32_t(((t & 0x07e0) << 5) | ((t & 0x0600) >> 5));
+                uint32_t t2 = uint32_t(((t & 0x07e0) << 5) | ((t & 0x0600) >> 1));
                 uint32_t t3 = uint32_t(((t & 0x001f) << 19) | ((t & 0x001c) << 14));
 
                 *(dPtr++) = t1 | t2 | t3 | 0xff000000;
@@ -797,7 +1147,12 @@ _Use_decl_annotations_ bool DirectX::_LoadScanline(
         LOAD_SCANLINE3(XMINT3, XMLoadSInt3, g_XMIdentityR3)
 
     case DXGI_FORMAT_R16G16B16A16_FLOAT:
-        LOAD_SCANLINE(XMHALF4, XMLoadHalf4)
+        if (size >= sizeof(XMHALF4))
+        {
+            LoadHalfScanline(dPtr, static_cast<const uint16_t*>(pSource), std::min<size_t>(count, size / sizeof(XMHALF4)), 4);
+            return true;
+        }
+        return false;
 
     case DXGI_FORMAT_R16G16B16A16_UNORM:
         LOAD_SCANLINE(XMUSHORTN4, XMLoadUShortN4)
@@ -883,7 +1238,12 @@ _Use_decl_annotations_ bool DirectX::_LoadScanline(
         LOAD_SCANLINE(XMUDEC4, XMLoadUDec4)
 
     case DXGI_FORMAT_R11G11B10_FLOAT:
-        LOAD_SCANLINE3(XMFLOAT3PK, XMLoadFloat3PK, g_XMIdentityR3)
+        if (size >= sizeof(XMFLOAT3PK))
+        {
+            LoadFloat3PKStream(dPtr, static_cast<const XMFLOAT3PK*>(pSource), std::min<size_t>(count, size / sizeof(XMFLOAT3PK)));
+            return true;
+        }
+        return false;
 
     case DXGI_FORMAT_R8G8B8A8_UNORM:
     case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
@@ -899,7 +1259,12 @@ _Use_decl_annotations_ bool DirectX::_LoadScanline(
         LOAD_SCANLINE(XMBYTE4, XMLoadByte4)
 
     case DXGI_FORMAT_R16G16_FLOAT:
-        LOAD_SCANLINE2(XMHALF2, XMLoadHalf2, g_XMIdentityR3)
+        if (size >= sizeof(XMHALF2))
+        {
+            LoadHalfScanline(dPtr, static_cast<const uint16_t*>(pSource), std::min<size_t>(count, size / sizeof(XMHALF2)), 2);
+            return true;
+        }
+        return false;
 
     case DXGI_FORMAT_R16G16_UNORM:
         LOAD_SCANLINE2(XMUSHORTN2, XMLoadUShortN2, g_XMIdentityR3)
@@ -1019,12 +1384,7 @@ _Use_decl_annotations_ bool DirectX::_LoadScanline(
     case DXGI_FORMAT_R16_FLOAT:
         if (size >= sizeof(HALF))
         {
-            const HALF * __restrict sPtr = static_cast<const HALF*>(pSource);
-            for (size_t icount = 0; icount < (size - sizeof(HALF) + 1); icount += sizeof(HALF))
-            {
-                if (dPtr >= ePtr) break;
-                *(dPtr++) = XMVectorSet(XMConvertHalfToFloat(*sPtr++), 0.f, 0.f, 1.f);
-            }
+            LoadHalfScanline(dPtr, static_cast<const uint16_t*>(pSource), std::min<size_t>(count, size / sizeof(HALF)), 1);
             return true;
         }
         return false;
@@ -1166,7 +1526,12 @@ _Use_decl_annotations_ bool DirectX::_LoadScanline(
         return false;
 
     case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
-        LOAD_SCANLINE3(XMFLOAT3SE, XMLoadFloat3SE, g_XMIdentityR3)
+        if (size >= sizeof(XMFLOAT3SE))
+        {
+            LoadFloat3SEStream(dPtr, static_cast<const XMFLOAT3SE*>(pSource), std::min<size_t>(count, size / sizeof(XMFLOAT3SE)));
+            return true;
+        }
+        return false;
 
     case DXGI_FORMAT_R8G8_B8G8_UNORM:
         if (size >= sizeof(XMUBYTEN4))
@@ -1644,14 +2009,7 @@ bool DirectX::_StoreScanline(
     case DXGI_FORMAT_R16G16B16A16_FLOAT:
         if (size >= sizeof(XMHALF4))
         {
-            XMHALF4* __restrict dPtr = static_cast<XMHALF4*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(XMHALF4) + 1); icount += sizeof(XMHALF4))
-            {
-                if (sPtr >= ePtr) break;
-                XMVECTOR v = *sPtr++;
-                v = XMVectorClamp(v, g_HalfMin, g_HalfMax);
-                XMStoreHalf4(dPtr++, v);
-            }
+            StoreHalfScanline(static_cast<uint16_t*>(pDestination), sPtr, std::min<size_t>(count, size / sizeof(XMHALF4)), 4);
             return true;
         }
         return false;
@@ -1709,7 +2067,12 @@ bool DirectX::_StoreScanline(
         STORE_SCANLINE(XMUDEC4, XMStoreUDec4)
 
     case DXGI_FORMAT_R11G11B10_FLOAT:
-        STORE_SCANLINE(XMFLOAT3PK, XMStoreFloat3PK)
+        if (size >= sizeof(XMFLOAT3PK))
+        {
+            StoreFloat3PKStream(static_cast<XMFLOAT3PK*>(pDestination), sPtr, std::min<size_t>(count, size / sizeof(XMFLOAT3PK)));
+            return true;
+        }
+        return false;
 
     case DXGI_FORMAT_R8G8B8A8_UNORM:
     case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
@@ -1738,14 +2101,7 @@ bool DirectX::_StoreScanline(
     case DXGI_FORMAT_R16G16_FLOAT:
         if (size >= sizeof(XMHALF2))
         {
-            XMHALF2* __restrict dPtr = static_cast<XMHALF2*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(XMHALF2) + 1); icount += sizeof(XMHALF2))
-            {
-                if (sPtr >= ePtr) break;
-                XMVECTOR v = *sPtr++;
-                v = XMVectorClamp(v, g_HalfMin, g_HalfMax);
-                XMStoreHalf2(dPtr++, v);
-            }
+            StoreHalfScanline(static_cast<uint16_t*>(pDestination), sPtr, std::min<size_t>(count, size / sizeof(XMHALF2)), 2);
             return true;
         }
         return false;
@@ -1837,14 +2193,7 @@ bool DirectX::_StoreScanline(
     case DXGI_FORMAT_R16_FLOAT:
         if (size >= sizeof(HALF))
         {
-            HALF * __restrict dPtr = static_cast<HALF*>(pDestination);
-            for (size_t icount = 0; icount < (size - sizeof(HALF) + 1); icount += sizeof(HALF))
-            {
-                if (sPtr >= ePtr) break;
-                float v = XMVectorGetX(*sPtr++);
-                v = std::max<float>(std::min<float>(v, 65504.f), -65504.f);
-                *(dPtr++) = XMConvertFloatToHalf(v);
-            }
+            StoreHalfScanline(static_cast<uint16_t*>(pDestination), sPtr, std::min<size_t>(count, size / sizeof(HALF)), 1);
             return true;
         }
         return false;
@@ -2010,7 +2359,12 @@ bool DirectX::_StoreScanline(
         return false;
 
     case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
-        STORE_SCANLINE(XMFLOAT3SE, StoreFloat3SE)
+        if (size >= sizeof(XMFLOAT3SE))
+        {
+            StoreFloat3SEStream(static_cast<XMFLOAT3SE*>(pDestination), sPtr, std::min<size_t>(count, size / sizeof(XMFLOAT3SE)));
+            return true;
+        }
+        return false;
 
     case DXGI_FORMAT_R8G8_B8G8_UNORM:
         if (size >= sizeof(XMUBYTEN4))
@@ -2627,6 +2981,69 @@ HRESULT DirectX::_ConvertFromR32G32B32A32(
 }
 
 
+//-------------------------------------------------------------------------------------
+// Bulk 16-bit float conversion
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+void DirectX::_ConvertHalfToFloatStream(float* pDestination, const uint16_t* pSource, size_t count) noexcept
+{
+    assert(pDestination && pSource);
+
+    size_t i = 0;
+
+#if defined(_XM_F16C_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+    for (; (i + 8) <= count; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i));
+        _mm256_storeu_ps(pDestination + i, _mm256_cvtph_ps(h));
+    }
+#elif defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+    for (; (i + 8) <= count; i += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i));
+        _mm_storeu_ps(pDestination + i, HalfToFloat4(_mm_unpacklo_epi16(h, _mm_setzero_si128())));
+        _mm_storeu_ps(pDestination + i + 4, HalfToFloat4(_mm_unpackhi_epi16(h, _mm_setzero_si128())));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        pDestination[i] = XMConvertHalfToFloat(pSource[i]);
+    }
+}
+
+_Use_decl_annotations_
+void DirectX::_ConvertFloatToHalfStream(uint16_t* pDestination, const float* pSource, size_t count) noexcept
+{
+    assert(pDestination && pSource);
+
+    size_t i = 0;
+
+#if defined(_XM_F16C_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+    for (; (i + 8) <= count; i += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(pSource + i), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), h);
+    }
+#elif defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+    for (; (i + 8) <= count; i += 8)
+    {
+        // Sign-extend so the saturating pack keeps all 16 bits
+        __m128i lo = FloatToHalf4(_mm_loadu_ps(pSource + i));
+        __m128i hi = FloatToHalf4(_mm_loadu_ps(pSource + i + 4));
+        lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+        hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i), _mm_packs_epi32(lo, hi));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        pDestination[i] = XMConvertFloatToHalf(pSource[i]);
+    }
+}
+
+
 //-------------------------------------------------------------------------------------
 // Convert DXGI image to/from GUID_WICPixelFormat64bppRGBAHalf (no range conversions)
 //-------------------------------------------------------------------------------------
@@ -2640,7 +3057,7 @@ HRESULT DirectX::_ConvertToR16G16B16A16(const Image& srcImage, ScratchImage& ima
     if (FAILED(hr))
         return hr;
 
-    ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR) * srcImage.width), 16)));
+    ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR) * srcImage.width), 16)));
     if (!scanline)
     {
         image.Release();
@@ -2670,9 +3087,9 @@ HRESULT DirectX::_ConvertToR16G16B16A16(const Image& srcImage, ScratchImage& ima
             return E_FAIL;
         }
 
-        XMConvertFloatToHalfStream(
-            reinterpret_cast<HALF*>(pDest), sizeof(HALF),
-            reinterpret_cast<float*>(scanline.get()), sizeof(float),
+        _ConvertFloatToHalfStream(
+            reinterpret_cast<uint16_t*>(pDest),
+            reinterpret_cast<const float*>(scanline.get()),
             srcImage.width * 4);
 
         pSrc += srcImage.rowPitch;
@@ -2693,7 +3110,7 @@ HRESULT DirectX::_ConvertFromR16G16B16A16(const Image& srcImage, const Image& de
     if (srcImage.width != destImage.width || srcImage.height != destImage.height)
         return E_FAIL;
 
-    ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR) * srcImage.width), 16)));
+    ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR) * srcImage.width), 16)));
     if (!scanline)
         return E_OUTOFMEMORY;
 
@@ -2702,9 +3119,9 @@ HRESULT DirectX::_ConvertFromR16G16B16A16(const Image& srcImage, const Image& de
 
     for (size_t h = 0; h < srcImage.height; ++h)
     {
-        XMConvertHalfToFloatStream(
-            reinterpret_cast<float*>(scanline.get()), sizeof(float),
-            reinterpret_cast<const HALF*>(pSrc), sizeof(HALF),
+        _ConvertHalfToFloatStream(
+            reinterpret_cast<float*>(scanline.get()),
+            reinterpret_cast<const uint16_t*>(pSrc),
             srcImage.width * 4);
 
         if (!_StoreScanline(pDest, destImage.rowPitch, destImage.format, scanline.get(), srcImage.width))
@@ -4577,6 +4994,12 @@ namespace
     //-------------------------------------------------------------------------------------
     // Convert the source image (not using WIC)
     //-------------------------------------------------------------------------------------
+    constexpr size_t CONVERT_PARALLEL_MIN_PIXELS = 16384;
+        // Images smaller than this are converted on the calling thread only
+
+    constexpr size_t DIFFUSION_BAND_ROWS = 32;
+        // Number of scanlines loaded & converted together ahead of the serial error diffusion pass
+
     HRESULT ConvertCustom(
         _In_ const Image& srcImage,
         _In_ TEX_FILTER_FLAGS filter,
@@ -4592,75 +5015,117 @@ namespace
         if (!pSrc || !pDest)
             return E_POINTER;
 
-        size_t width = srcImage.width;
+        const size_t width = srcImage.width;
+
+#ifdef _OPENMP
+        const bool parallel = (srcImage.height > 1) && ((width * srcImage.height) >= CONVERT_PARALLEL_MIN_PIXELS);
+#endif
+
+        bool fail = false;
 
         if (filter & TEX_FILTER_DITHER_DIFFUSION)
         {
             // Error diffusion dithering (aka Floyd-Steinberg dithering)
-            ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*(width * 2 + 2)), 16)));
+            //
+            // The serpentine scan order means the first pixel of each scanline needs the error terms from the last pixel of the
+            // scanline above, so the dither itself is strictly serial. Instead a band of scanlines is loaded & converted in
+            // parallel, and then dithered in order which keeps the result identical to a fully serial conversion.
+            const size_t bandRows = std::min<size_t>(DIFFUSION_BAND_ROWS, srcImage.height);
+
+            ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*(width * (bandRows + 1) + 2)), 16)));
             if (!scanline)
                 return E_OUTOFMEMORY;
 
-            XMVECTOR* pDiffusionErrors = scanline.get() + width;
+            XMVECTOR* pDiffusionErrors = scanline.get() + width * bandRows;
             memset(pDiffusionErrors, 0, sizeof(XMVECTOR)*(width + 2));
 
-            for (size_t h = 0; h < srcImage.height; ++h)
+            for (size_t h = 0; h < srcImage.height; h += bandRows)
             {
-                if (!_LoadScanline(scanline.get(), width, pSrc, srcImage.rowPitch, srcImage.format))
-                    return E_FAIL;
+                const size_t rows = std::min<size_t>(bandRows, srcImage.height - h);
+
+#ifdef _OPENMP
+#pragma omp parallel for if (parallel)
+#endif
+                for (int r = 0; r < static_cast<int>(rows); ++r)
+                {
+                    XMVECTOR* row = scanline.get() + width * size_t(r);
 
-                _ConvertScanline(scanline.get(), width, destImage.format, srcImage.format, filter);
+                    if (!_LoadScanline(row, width, pSrc + srcImage.rowPitch * size_t(r), srcImage.rowPitch, srcImage.format))
+                    {
+                        fail = true;
+                        continue;
+                    }
+
+                    _ConvertScanline(row, width, destImage.format, srcImage.format, filter);
+                }
 
-                if (!_StoreScanlineDither(pDest, destImage.rowPitch, destImage.format, scanline.get(), width, threshold, h, z, pDiffusionErrors))
+                if (fail)
                     return E_FAIL;
 
-                pSrc += srcImage.rowPitch;
-                pDest += destImage.rowPitch;
+                for (size_t r = 0; r < rows; ++r)
+                {
+                    if (!_StoreScanlineDither(pDest, destImage.rowPitch, destImage.format, scanline.get() + width * r, width, threshold, h + r, z, pDiffusionErrors))
+                        return E_FAIL;
+
+                    pDest += destImage.rowPitch;
+                }
+
+                pSrc += srcImage.rowPitch * rows;
             }
         }
         else
         {
-            ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width), 16)));
-            if (!scanline)
-                return E_OUTOFMEMORY;
+            // Each scanline is independent, so rows are distributed across threads with a scanline buffer per thread
+            bool oom = false;
 
-            if (filter & TEX_FILTER_DITHER)
+#ifdef _OPENMP
+#pragma omp parallel if (parallel)
+#endif
             {
-                // Ordered dithering
-                for (size_t h = 0; h < srcImage.height; ++h)
-                {
-                    if (!_LoadScanline(scanline.get(), width, pSrc, srcImage.rowPitch, srcImage.format))
-                        return E_FAIL;
+                ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*width), 16)));
 
-                    _ConvertScanline(scanline.get(), width, destImage.format, srcImage.format, filter);
+#ifdef _OPENMP
+#pragma omp for
+#endif
+                for (int h = 0; h < static_cast<int>(srcImage.height); ++h)
+                {
+                    if (!scanline)
+                    {
+                        oom = true;
+                        continue;
+                    }
 
-                    if (!_StoreScanlineDither(pDest, destImage.rowPitch, destImage.format, scanline.get(), width, threshold, h, z, nullptr))
-                        return E_FAIL;
+                    const uint8_t* sPtr = pSrc + srcImage.rowPitch * size_t(h);
+                    uint8_t* dPtr = pDest + destImage.rowPitch * size_t(h);
 
-                    pSrc += srcImage.rowPitch;
-                    pDest += destImage.rowPitch;
-                }
-            }
-            else
-            {
-                // No dithering
-                for (size_t h = 0; h < srcImage.height; ++h)
-                {
-                    if (!_LoadScanline(scanline.get(), width, pSrc, srcImage.rowPitch, srcImage.format))
-                        return E_FAIL;
+                    if (!_LoadScanline(scanline.get(), width, sPtr, srcImage.rowPitch, srcImage.format))
+                    {
+                        fail = true;
+                        continue;
+                    }
 
                     _ConvertScanline(scanline.get(), width, destImage.format, srcImage.format, filter);
 
-                    if (!_StoreScanline(pDest, destImage.rowPitch, destImage.format, scanline.get(), width, threshold))
-                        return E_FAIL;
-
-                    pSrc += srcImage.rowPitch;
-                    pDest += destImage.rowPitch;
+                    if (filter & TEX_FILTER_DITHER)
+                    {
+                        // Ordered dithering
+                        if (!_StoreScanlineDither(dPtr, destImage.rowPitch, destImage.format, scanline.get(), width, threshold, size_t(h), z, nullptr))
+                            fail = true;
+                    }
+                    else
+                    {
+                        // No dithering
+                        if (!_StoreScanline(dPtr, destImage.rowPitch, destImage.format, scanline.get(), width, threshold))
+                            fail = true;
+                    }
                 }
             }
+
+            if (oom)
+                return E_OUTOFMEMORY;
         }
 
-        return S_OK;
+        return (fail) ? E_FAIL : S_OK;
     }
 
     //-------------------------------------------------------------------------------------
@@ -4812,16 +5277,363 @@ namespace
     }
 
 #undef CONVERT_420_TO_422
-}
 
+    //-------------------------------------------------------------------------------------
+    // Direct Y'CbCr to RGB conversion
+    //-------------------------------------------------------------------------------------
+    struct YUVTransform
+    {
+        XMMATRIX    m;      // Rows scale the raw Y, Cb, Cr, and A codes
+        XMVECTOR    bias;   // Removes the code offsets (and sets opaque alpha if the source has none)
+    };
 
-//=====================================================================================
-// Entry-points
-//=====================================================================================
+    bool ComputeYUVTransform(
+        _In_ DXGI_FORMAT format,
+        _In_ TEX_YUV_FLAGS flags,
+        _Out_ YUVTransform& transform) noexcept
+    {
+        size_t bits = 0;        // Significant bits per channel
+        size_t shift = 0;       // Zero LSBs for MSB-aligned data stored in 16-bit containers
+        float alphaMax = 0.f;   // Maximum alpha code (zero for formats without alpha)
+
+        switch (format)
+        {
+        case DXGI_FORMAT_NV12:
+        case DXGI_FORMAT_NV11:
+        case DXGI_FORMAT_YUY2:
+            bits = 8;
+            break;
+
+        case DXGI_FORMAT_AYUV:
+            bits = 8;
+            alphaMax = 255.f;
+            break;
+
+        case DXGI_FORMAT_P010:
+        case DXGI_FORMAT_Y210:
+            bits = 10;
+            shift = 6;
+            break;
+
+        case DXGI_FORMAT_Y410:
+            bits = 10;
+            alphaMax = 3.f;
+            break;
+
+        case DXGI_FORMAT_P016:
+        case DXGI_FORMAT_Y216:
+            bits = 16;
+            break;
+
+        case DXGI_FORMAT_Y416:
+            bits = 16;
+            alphaMax = 65535.f;
+            break;
+
+        default:
+            return false;
+        }
+
+        // Luma weights
+        float kr, kb;
+        switch (flags & TEX_YUV_MATRIX_MASK)
+        {
+        case TEX_YUV_BT601:
+            kr = 0.299f;
+            kb = 0.114f;
+            break;
+
+        case TEX_YUV_BT709:
+            kr = 0.2126f;
+            kb = 0.0722f;
+            break;
+
+        case TEX_YUV_BT2020:
+            kr = 0.2627f;
+            kb = 0.0593f;
+            break;
+
+        default:
+            return false;
+        }
+
+        const float kg = 1.f - kr - kb;
+
+        float yOffset, yRange, cOffset, cRange;
+        if (flags & TEX_YUV_FULL_RANGE)
+        {
+            yOffset = 0.f;
+            yRange = float((uint32_t(1) << bits) - 1);
+            cOffset = float(uint32_t(1) << (bits - 1));
+            cRange = yRange;
+        }
+        else
+        {
+            // Limited range is defined for 8-bit and scaled up for higher bit-depths
+            const auto step = float(uint32_t(1) << (bits - 8));
+            yOffset = 16.f * step;
+            yRange = 219.f * step;
+            cOffset = 128.f * step;
+            cRange = 224.f * step;
+        }
+
+        // R = Y' + 2(1 - Kr)Cr'
+        // G = Y' - (2Kb(1 - Kb) / Kg)Cb' - (2Kr(1 - Kr) / Kg)Cr'
+        // B = Y' + 2(1 - Kb)Cb'
+        const float rcr = 2.f * (1.f - kr);
+        const float gcb = -2.f * kb * (1.f - kb) / kg;
+        const float gcr = -2.f * kr * (1.f - kr) / kg;
+        const float bcb = 2.f * (1.f - kb);
+
+        const float unpack = 1.f / float(uint32_t(1) << shift);
+        const float ys = unpack / yRange;
+        const float cs = unpack / cRange;
+        const float yo = yOffset / yRange;
+        const float co = cOffset / cRange;
+
+        transform.m = XMMATRIX(
+            ys, ys, ys, 0.f,
+            0.f, gcb * cs, bcb * cs, 0.f,
+            rcr * cs, gcr * cs, 0.f, 0.f,
+            0.f, 0.f, 0.f, (alphaMax > 0.f) ? (1.f / alphaMax) : 0.f);
+
+        transform.bias = XMVectorSet(
+            -yo - rcr * co,
+            -yo - (gcb + gcr) * co,
+            -yo - bcb * co,
+            (alphaMax > 0.f) ? 0.f : 1.f);
+
+        return true;
+    }
+
+    // Loads a scanline of raw Y, Cb, Cr, A codes
+    _Success_(return != false)
+    bool LoadYUVScanline(
+        _Out_writes_(count) XMVECTOR* pDestination,
+        size_t count,
+        _In_ const Image& image,
+        size_t y) noexcept
+    {
+        assert(pDestination && count > 0);
+        assert(y < image.height);
+
+        const uint8_t* pEnd = image.pixels + image.slicePitch;
+        const uint8_t* pRow = image.pixels + image.rowPitch * y;
+
+        XMVECTOR* __restrict dPtr = pDestination;
+
+        switch (image.format)
+        {
+        case DXGI_FORMAT_AYUV:
+            // V, U, Y, A
+            if ((pRow + sizeof(XMUBYTE4) * count) > pEnd)
+                return false;
+            {
+                auto sPtr = reinterpret_cast<const XMUBYTE4*>(pRow);
+                for (size_t x = 0; x < count; ++x)
+                {
+                    *(dPtr++) = XMVectorSwizzle<2, 1, 0, 3>(XMLoadUByte4(sPtr++));
+                }
+            }
+            return true;
+
+        case DXGI_FORMAT_Y410:
+            // U, Y, V, A
+            if ((pRow + sizeof(XMUDEC4) * count) > pEnd)
+                return false;
+            {
+                auto sPtr = reinterpret_cast<const XMUDEC4*>(pRow);
+                for (size_t x = 0; x < count; ++x)
+                {
+                    *(dPtr++) = XMVectorSwizzle<1, 0, 2, 3>(XMLoadUDec4(sPtr++));
+                }
+            }
+            return true;
+
+        case DXGI_FORMAT_Y416:
+            // U, Y, V, A
+            if ((pRow + sizeof(XMUSHORT4) * count) > pEnd)
+                return false;
+            {
+                auto sPtr = reinterpret_cast<const XMUSHORT4*>(pRow);
+                for (size_t x = 0; x < count; ++x)
+                {
+                    *(dPtr++) = XMVectorSwizzle<1, 0, 2, 3>(XMLoadUShort4(sPtr++));
+                }
+            }
+            return true;
+
+        case DXGI_FORMAT_YUY2:
+            // Y0, U, Y1, V
+            if ((pRow + sizeof(XMUBYTE4) * ((count + 1) >> 1)) > pEnd)
+                return false;
+            {
+                auto sPtr = reinterpret_cast<const XMUBYTE4*>(pRow);
+                for (size_t x = 0; x < count; x += 2)
+                {
+                    XMVECTOR v = XMLoadUByte4(sPtr++);
+                    *(dPtr++) = XMVectorAndInt(XMVectorSwizzle<0, 1, 3, 3>(v), g_XMMask3);
+                    if ((x + 1) < count)
+                        *(dPtr++) = XMVectorAndInt(XMVectorSwizzle<2, 1, 3, 3>(v), g_XMMask3);
+                }
+            }
+            return true;
+
+        case DXGI_FORMAT_Y210:
+        case DXGI_FORMAT_Y216:
+            // Y0, U, Y1, V
+            if ((pRow + sizeof(XMUSHORT4) * ((count + 1) >> 1)) > pEnd)
+                return false;
+            {
+                auto sPtr = reinterpret_cast<const XMUSHORT4*>(pRow);
+                for (size_t x = 0; x < count; x += 2)
+                {
+                    XMVECTOR v = XMLoadUShort4(sPtr++);
+                    *(dPtr++) = XMVectorAndInt(XMVectorSwizzle<0, 1, 3, 3>(v), g_XMMask3);
+                    if ((x + 1) < count)
+                        *(dPtr++) = XMVectorAndInt(XMVectorSwizzle<2, 1, 3, 3>(v), g_XMMask3);
+                }
+            }
+            return true;
+
+        case DXGI_FORMAT_NV12:
+            // Y plane followed by an interleaved U, V plane at half horizontal and vertical resolution
+            {
+                const uint8_t* pUV = image.pixels + image.rowPitch * (image.height + (y >> 1));
+                if ((pRow + count) > pEnd || (pUV + ((count + 1) >> 1) * 2) > pEnd)
+                    return false;
+
+                const uint8_t* sPtrY = pRow;
+                const uint8_t* sPtrUV = pUV;
+                for (size_t x = 0; x < count; x += 2)
+                {
+                    XMVECTOR uv = XMVectorSet(0.f, float(sPtrUV[0]), float(sPtrUV[1]), 0.f);
+                    sPtrUV += 2;
+
+                    *(dPtr++) = XMVectorSetX(uv, float(*(sPtrY++)));
+                    if ((x + 1) < count)
+                        *(dPtr++) = XMVectorSetX(uv, float(*(sPtrY++)));
+                }
+            }
+            return true;
+
+        case DXGI_FORMAT_P010:
+        case DXGI_FORMAT_P016:
+            // See NV12
+            {
+                const uint8_t* pUV = image.pixels + image.rowPitch * (image.height + (y >> 1));
+                if ((pRow + sizeof(uint16_t) * count) > pEnd || (pUV + sizeof(uint16_t) * ((count + 1) >> 1) * 2) > pEnd)
+                    return false;
+
+                auto sPtrY = reinterpret_cast<const uint16_t*>(pRow);
+                auto sPtrUV = reinterpret_cast<const uint16_t*>(pUV);
+                for (size_t x = 0; x < count; x += 2)
+                {
+                    XMVECTOR uv = XMVectorSet(0.f, float(sPtrUV[0]), float(sPtrUV[1]), 0.f);
+                    sPtrUV += 2;
+
+                    *(dPtr++) = XMVectorSetX(uv, float(*(sPtrY++)));
+                    if ((x + 1) < count)
+                        *(dPtr++) = XMVectorSetX(uv, float(*(sPtrY++)));
+                }
+            }
+            return true;
+
+        case DXGI_FORMAT_NV11:
+            // Y plane followed by an interleaved U, V plane at quarter horizontal resolution (see ConvertToSinglePlane_)
+            {
+                const uint8_t* pUV = image.pixels + image.rowPitch * image.height + (image.rowPitch >> 1) * y;
+                if ((pRow + count) > pEnd || (pUV + ((count + 3) >> 2) * 2) > pEnd)
+                    return false;
+
+                const uint8_t* sPtrY = pRow;
+                const uint8_t* sPtrUV = pUV;
+                for (size_t x = 0; x < count; ++x)
+                {
+                    XMVECTOR uv = XMVectorSet(float(*sPtrY++), float(sPtrUV[(x >> 2) * 2]), float(sPtrUV[(x >> 2) * 2 + 1]), 0.f);
+                    *(dPtr++) = uv;
+                }
+            }
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    HRESULT ConvertFromYUV_(
+        _In_ const Image& srcImage,
+        _In_ const YUVTransform& transform,
+        _In_ const Image& destImage) noexcept
+    {
+        assert(srcImage.width == destImage.width);
+        assert(srcImage.height == destImage.height);
+
+        if (!srcImage.pixels || !destImage.pixels)
+            return E_POINTER;
+
+        const size_t width = srcImage.width;
+
+        bool fail = false;
+        bool oom = false;
+
+#ifdef _OPENMP
+#pragma omp parallel if ((srcImage.height > 1) && ((width * srcImage.height) >= CONVERT_PARALLEL_MIN_PIXELS))
+#endif
+        {
+            ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*width), 16)));
+
+#ifdef _OPENMP
+#pragma omp for
+#endif
+            for (int h = 0; h < static_cast<int>(srcImage.height); ++h)
+            {
+                if (!scanline)
+                {
+                    oom = true;
+                    continue;
+                }
+
+                XMVECTOR* ptr = scanline.get();
+                if (!LoadYUVScanline(ptr, width, srcImage, size_t(h)))
+                {
+                    fail = true;
+                    continue;
+                }
+
+                for (size_t i = 0; i < width; ++i, ++ptr)
+                {
+                    XMVECTOR v = XMVector4Transform(*ptr, transform.m);
+                    *ptr = XMVectorSaturate(XMVectorAdd(v, transform.bias));
+                }
+
+                if (!_StoreScanline(destImage.pixels + destImage.rowPitch * size_t(h), destImage.rowPitch, destImage.format, scanline.get(), width))
+                    fail = true;
+            }
+        }
+
+        if (oom)
+            return E_OUTOFMEMORY;
+
+        return (fail) ? E_FAIL : S_OK;
+    }
+
+    bool IsYUVTargetSupported(_In_ DXGI_FORMAT format) noexcept
+    {
+        return IsValid(format)
+            && !IsCompressed(format) && !IsPlanar(format) && !IsPalettized(format)
+            && !IsTypeless(format) && !IsVideo(format);
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
 
 //-------------------------------------------------------------------------------------
-// Convert image
-//-------------------------------------------------------------------------------------
+// Convert image
+//-------------------------------------------------------------------------------------
 _Use_decl_annotations_
 HRESULT DirectX::Convert(
     const Image& srcImage,
@@ -5035,6 +5847,123 @@ HRESULT DirectX::Convert(
 }
 
 
+//-------------------------------------------------------------------------------------
+// Convert image in-place
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ConvertInPlace(
+    ScratchImage& image,
+    DXGI_FORMAT format,
+    TEX_FILTER_FLAGS filter,
+    float threshold) noexcept
+{
+    const TexMetadata& metadata = image.GetMetadata();
+
+    const Image* images = image.GetImages();
+    const size_t nimages = image.GetImageCount();
+    if (!images || !nimages || (metadata.format == format) || !IsValid(format))
+        return E_INVALIDARG;
+
+    if (IsCompressed(metadata.format) || IsCompressed(format)
+        || IsPlanar(metadata.format) || IsPlanar(format)
+        || IsPalettized(metadata.format) || IsPalettized(format)
+        || IsTypeless(metadata.format) || IsTypeless(format))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    if ((metadata.width > UINT32_MAX) || (metadata.height > UINT32_MAX))
+        return E_INVALIDARG;
+
+    // Scanlines are rewritten in the existing buffer, so the pixel footprint of both formats must be identical
+    const bool inplace = !(filter & TEX_FILTER_FORCE_WIC)
+        && !IsPacked(metadata.format) && !IsPacked(format)
+        && (BitsPerPixel(metadata.format) == BitsPerPixel(format));
+
+    if (!inplace)
+    {
+        ScratchImage result;
+        HRESULT hr = Convert(images, nimages, metadata, format, filter, threshold, result);
+        if (FAILED(hr))
+        {
+            image.Release();
+            return hr;
+        }
+
+        image = std::move(result);
+        return S_OK;
+    }
+
+    for (size_t index = 0; index < nimages; ++index)
+    {
+        const Image& img = images[index];
+        if (img.format != metadata.format || !img.pixels)
+        {
+            image.Release();
+            return E_FAIL;
+        }
+    }
+
+    HRESULT hr = S_OK;
+
+    switch (metadata.dimension)
+    {
+    case TEX_DIMENSION_TEXTURE1D:
+    case TEX_DIMENSION_TEXTURE2D:
+        for (size_t index = 0; index < nimages && SUCCEEDED(hr); ++index)
+        {
+            const Image& src = images[index];
+
+            Image dst = src;
+            dst.format = format;
+
+            hr = ConvertCustom(src, filter, dst, threshold, 0);
+        }
+        break;
+
+    case TEX_DIMENSION_TEXTURE3D:
+    {
+        size_t index = 0;
+        size_t d = metadata.depth;
+        for (size_t level = 0; level < metadata.mipLevels && SUCCEEDED(hr); ++level)
+        {
+            for (size_t slice = 0; slice < d; ++slice, ++index)
+            {
+                if (index >= nimages)
+                {
+                    hr = E_FAIL;
+                    break;
+                }
+
+                const Image& src = images[index];
+
+                Image dst = src;
+                dst.format = format;
+
+                hr = ConvertCustom(src, filter, dst, threshold, slice);
+                if (FAILED(hr))
+                    break;
+            }
+
+            if (d > 1)
+                d >>= 1;
+        }
+    }
+    break;
+
+    default:
+        hr = E_FAIL;
+        break;
+    }
+
+    if (FAILED(hr) || !image.OverrideFormat(format))
+    {
+        image.Release();
+        return FAILED(hr) ? hr : E_FAIL;
+    }
+
+    return S_OK;
+}
+
+
 //-------------------------------------------------------------------------------------
 // Convert image from planar to single plane (image)
 //-------------------------------------------------------------------------------------
@@ -5154,6 +6083,140 @@ HRESULT DirectX::ConvertToSinglePlane(
 }
 
 
+//-------------------------------------------------------------------------------------
+// Convert image from YUV to RGB (image)
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ConvertFromYUV(
+    const Image& srcImage,
+    DXGI_FORMAT format,
+    TEX_YUV_FLAGS flags,
+    ScratchImage& image) noexcept
+{
+    if (!IsVideo(srcImage.format))
+        return E_INVALIDARG;
+
+    if (!srcImage.pixels)
+        return E_POINTER;
+
+    if (!IsYUVTargetSupported(format))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    YUVTransform transform;
+    if (!ComputeYUVTransform(srcImage.format, flags, transform))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    if ((srcImage.width > UINT32_MAX) || (srcImage.height > UINT32_MAX))
+        return E_INVALIDARG;
+
+    HRESULT hr = image.Initialize2D(format, srcImage.width, srcImage.height, 1, 1);
+    if (FAILED(hr))
+        return hr;
+
+    const Image *rimage = image.GetImage(0, 0, 0);
+    if (!rimage)
+    {
+        image.Release();
+        return E_POINTER;
+    }
+
+    hr = ConvertFromYUV_(srcImage, transform, *rimage);
+    if (FAILED(hr))
+    {
+        image.Release();
+        return hr;
+    }
+
+    return S_OK;
+}
+
+
+//-------------------------------------------------------------------------------------
+// Convert image from YUV to RGB (complex)
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::ConvertFromYUV(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    DXGI_FORMAT format,
+    TEX_YUV_FLAGS flags,
+    ScratchImage& result) noexcept
+{
+    if (!srcImages || !nimages || !IsVideo(metadata.format))
+        return E_INVALIDARG;
+
+    if (metadata.IsVolumemap() && IsPlanar(metadata.format))
+    {
+        // Direct3D does not support any planar formats for Texture3D
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    if (!IsYUVTargetSupported(format))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    YUVTransform transform;
+    if (!ComputeYUVTransform(metadata.format, flags, transform))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    if ((metadata.width > UINT32_MAX) || (metadata.height > UINT32_MAX))
+        return E_INVALIDARG;
+
+    TexMetadata mdata2 = metadata;
+    mdata2.format = format;
+    HRESULT hr = result.Initialize(mdata2);
+    if (FAILED(hr))
+        return hr;
+
+    if (nimages != result.GetImageCount())
+    {
+        result.Release();
+        return E_FAIL;
+    }
+
+    const Image* dest = result.GetImages();
+    if (!dest)
+    {
+        result.Release();
+        return E_POINTER;
+    }
+
+    for (size_t index = 0; index < nimages; ++index)
+    {
+        const Image& src = srcImages[index];
+        if (src.format != metadata.format)
+        {
+            result.Release();
+            return E_FAIL;
+        }
+
+        if ((src.width > UINT32_MAX) || (src.height > UINT32_MAX))
+        {
+            result.Release();
+            return E_FAIL;
+        }
+
+        const Image& dst = dest[index];
+        assert(dst.format == format);
+
+        if (src.width != dst.width || src.height != dst.height)
+        {
+            result.Release();
+            return E_FAIL;
+        }
+
+        hr = ConvertFromYUV_(src, transform, dst);
+        if (FAILED(hr))
+        {
+            result.Release();
+            return hr;
+        }
+    }
+
+    return S_OK;
+}
+
+
 //-------------------------------------------------------------------------------------
 // Returns the data type of a DXGI_FORMAT
 //-------------------------------------------------------------------------------------
@@ -13,6 +13,10 @@
 
 #include "DDS.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace DirectX;
 
 static_assert(static_cast<int>(TEX_DIMENSION_TEXTURE1D) == static_cast<int>(DDS_DIMENSION_TEXTURE1D), "header enum mismatch");
@@ -1219,6 +1223,238 @@ namespace
     }
 
 
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+    //-------------------------------------------------------------------------------------
+    // SSE2 expansion of 16bpp packed and luminance formats to DXGI_FORMAT_R8G8B8A8_UNORM
+    // (bit-exact with the scalar expanders); returns the number of pixels converted
+    //-------------------------------------------------------------------------------------
+    template<int mask, int shift> inline __m128i BitsLeft(__m128i t) noexcept
+    {
+        return _mm_slli_epi32(_mm_and_si128(t, _mm_set1_epi32(mask)), shift);
+    }
+
+    template<int mask, int shift> inline __m128i BitsRight(__m128i t) noexcept
+    {
+        return _mm_srli_epi32(_mm_and_si128(t, _mm_set1_epi32(mask)), shift);
+    }
+
+    inline __m128i Expand16(__m128i t, uint32_t convFlags, bool setAlpha) noexcept
+    {
+        const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+
+        if (convFlags & CONV_FLAGS_565)
+        {
+            __m128i r = _mm_or_si128(BitsRight<0xf800, 8>(t), BitsRight<0xe000, 13>(t));
+            __m128i g = _mm_or_si128(BitsLeft<0x07e0, 5>(t), BitsRight<0x0600, 1>(t));
+            __m128i b = _mm_or_si128(BitsLeft<0x001f, 19>(t), BitsLeft<0x001c, 14>(t));
+            return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, alpha));
+        }
+        else if (convFlags & CONV_FLAGS_5551)
+        {
+            __m128i r = _mm_or_si128(BitsRight<0x7c00, 7>(t), BitsRight<0x7000, 12>(t));
+            __m128i g = _mm_or_si128(BitsLeft<0x03e0, 6>(t), BitsLeft<0x0380, 1>(t));
+            __m128i b = _mm_or_si128(BitsLeft<0x001f, 19>(t), BitsLeft<0x001c, 14>(t));
+            __m128i a = (setAlpha) ? alpha : _mm_and_si128(_mm_srai_epi32(_mm_slli_epi32(t, 16), 31), alpha);
+            return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+        }
+        else if (convFlags & CONV_FLAGS_4444)
+        {
+            __m128i r = _mm_or_si128(BitsRight<0x0f00, 4>(t), BitsRight<0x0f00, 8>(t));
+            __m128i g = _mm_or_si128(BitsLeft<0x00f0, 8>(t), BitsLeft<0x00f0, 4>(t));
+            __m128i b = _mm_or_si128(BitsLeft<0x000f, 20>(t), BitsLeft<0x000f, 16>(t));
+            __m128i a = (setAlpha) ? alpha : _mm_or_si128(BitsLeft<0xf000, 16>(t), BitsLeft<0xf000, 12>(t));
+            return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+        }
+        else
+        {
+            // CONV_FLAGS_A8L8
+            __m128i l = _mm_and_si128(t, _mm_set1_epi32(0xff));
+            l = _mm_or_si128(l, _mm_or_si128(_mm_slli_epi32(l, 8), _mm_slli_epi32(l, 16)));
+            __m128i a = (setAlpha) ? alpha : BitsLeft<0xff00, 16>(t);
+            return _mm_or_si128(l, a);
+        }
+    }
+
+    size_t ExpandScanlineSSE(
+        _Out_writes_bytes_(outSize) void* pDestination,
+        size_t outSize,
+        _In_reads_bytes_(inSize) const void* pSource,
+        size_t inSize,
+        uint32_t convFlags,
+        uint32_t tflags) noexcept
+    {
+        auto sPtr = static_cast<const uint8_t*>(pSource);
+        auto dPtr = static_cast<uint8_t*>(pDestination);
+
+        if (convFlags & (CONV_FLAGS_PAL8 | CONV_FLAGS_888 | CONV_FLAGS_332 | CONV_FLAGS_8332 | CONV_FLAGS_44 | CONV_FLAGS_L16))
+            return 0;
+
+        if (!(convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444)) && (convFlags & CONV_FLAGS_L8))
+        {
+            const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+
+            const size_t count = std::min(inSize, outSize / 4) & ~size_t(15);
+            for (size_t j = 0; j < count; j += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sPtr + j));
+                const __m128i lo = _mm_unpacklo_epi8(v, v);
+                const __m128i hi = _mm_unpackhi_epi8(v, v);
+
+                auto dest = reinterpret_cast<__m128i*>(dPtr + j * 4);
+                _mm_storeu_si128(dest, _mm_or_si128(_mm_unpacklo_epi16(lo, lo), alpha));
+                _mm_storeu_si128(dest + 1, _mm_or_si128(_mm_unpackhi_epi16(lo, lo), alpha));
+                _mm_storeu_si128(dest + 2, _mm_or_si128(_mm_unpacklo_epi16(hi, hi), alpha));
+                _mm_storeu_si128(dest + 3, _mm_or_si128(_mm_unpackhi_epi16(hi, hi), alpha));
+            }
+            return count;
+        }
+
+        if (!(convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444 | CONV_FLAGS_A8L8)))
+            return 0;
+
+        const bool setAlpha = (tflags & TEXP_SCANLINE_SETALPHA) != 0;
+        const __m128i zero = _mm_setzero_si128();
+
+        const size_t count = std::min(inSize / 2, outSize / 4) & ~size_t(7);
+        for (size_t j = 0; j < count; j += 8)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sPtr + j * 2));
+
+            auto dest = reinterpret_cast<__m128i*>(dPtr + j * 4);
+            _mm_storeu_si128(dest, Expand16(_mm_unpacklo_epi16(v, zero), convFlags, setAlpha));
+            _mm_storeu_si128(dest + 1, Expand16(_mm_unpackhi_epi16(v, zero), convFlags, setAlpha));
+        }
+        return count;
+    }
+#endif
+
+    //-------------------------------------------------------------------------------------
+    // Converts one row of legacy or swizzled pixel data into the loaded format
+    //-------------------------------------------------------------------------------------
+    _Success_(return != false)
+        bool ConvertScanline(
+            _Out_writes_bytes_(outSize) void* pDestination,
+            size_t outSize,
+            _In_ DXGI_FORMAT outFormat,
+            _In_reads_bytes_(inSize) const void* pSource,
+            size_t inSize,
+            _In_ uint32_t convFlags,
+            _In_reads_opt_(256) const uint32_t* pal8,
+            _In_ uint32_t tflags) noexcept
+    {
+        if (convFlags & CONV_FLAGS_EXPAND)
+        {
+        #if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+            if (outFormat == DXGI_FORMAT_R8G8B8A8_UNORM)
+            {
+                const size_t done = ExpandScanlineSSE(pDestination, outSize, pSource, inSize, convFlags, tflags);
+                if (done > 0)
+                {
+                    // Finish any remaining pixels with the scalar code below
+                    const size_t sbpp = (convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444 | CONV_FLAGS_A8L8)) ? 2 : 1;
+                    if (done >= std::min(inSize / sbpp, outSize / 4))
+                        return true;
+
+                    pDestination = static_cast<uint8_t*>(pDestination) + done * 4;
+                    outSize -= done * 4;
+                    pSource = static_cast<const uint8_t*>(pSource) + done * sbpp;
+                    inSize -= done * sbpp;
+                }
+            }
+        #endif
+
+            if (convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444))
+            {
+                DXGI_FORMAT inFormat = DXGI_FORMAT_B5G5R5A1_UNORM;
+                if (convFlags & CONV_FLAGS_565)
+                    inFormat = DXGI_FORMAT_B5G6R5_UNORM;
+                else if (convFlags & CONV_FLAGS_4444)
+                    inFormat = DXGI_FORMAT_B4G4R4A4_UNORM;
+
+                return _ExpandScanline(pDestination, outSize, DXGI_FORMAT_R8G8B8A8_UNORM, pSource, inSize, inFormat, tflags);
+            }
+            else
+            {
+                TEXP_LEGACY_FORMAT lformat = _FindLegacyFormat(convFlags);
+                return LegacyExpandScanline(pDestination, outSize, outFormat, pSource, inSize, lformat, pal8, tflags);
+            }
+        }
+        else if (convFlags & CONV_FLAGS_SWIZZLE)
+        {
+            _SwizzleScanline(pDestination, outSize, pSource, inSize, outFormat, tflags);
+        }
+        else
+        {
+            _CopyScanline(pDestination, outSize, pSource, inSize, outFormat, tflags);
+        }
+
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Converts the rows of one subresource, splitting large images into bands across threads
+    //-------------------------------------------------------------------------------------
+    constexpr size_t DDS_PARALLEL_MIN_BYTES = 0x100000;
+        // Smallest destination image which is converted in parallel
+
+    HRESULT ConvertRows(
+        _Out_writes_bytes_(dpitch * rows) uint8_t* pDest,
+        size_t dpitch,
+        _In_reads_bytes_(spitch * rows) const uint8_t* pSrc,
+        size_t spitch,
+        size_t rows,
+        _In_ DXGI_FORMAT format,
+        _In_ uint32_t convFlags,
+        _In_reads_opt_(256) const uint32_t* pal8,
+        _In_ uint32_t tflags) noexcept
+    {
+    #ifdef _OPENMP
+        if (rows > 1 && rows <= INT32_MAX && (dpitch * rows) >= DDS_PARALLEL_MIN_BYTES && !omp_in_parallel())
+        {
+            bool fail = false;
+
+            #pragma omp parallel for
+            for (int h = 0; h < static_cast<int>(rows); ++h)
+            {
+                if (!ConvertScanline(pDest + size_t(h) * dpitch, dpitch, format, pSrc + size_t(h) * spitch, spitch, convFlags, pal8, tflags))
+                    fail = true;
+            }
+
+            return (fail) ? E_FAIL : S_OK;
+        }
+    #endif
+
+        for (size_t h = 0; h < rows; ++h)
+        {
+            if (!ConvertScanline(pDest, dpitch, format, pSrc, spitch, convFlags, pal8, tflags))
+                return E_FAIL;
+
+            pSrc += spitch;
+            pDest += dpitch;
+        }
+
+        return S_OK;
+    }
+
+
+    //-------------------------------------------------------------------------------------
+    // Pitch flags describing the legacy pixel layout stored in the file
+    //-------------------------------------------------------------------------------------
+    CP_FLAGS GetSourcePitchFlags(CP_FLAGS cpFlags, uint32_t convFlags) noexcept
+    {
+        if (convFlags & CONV_FLAGS_EXPAND)
+        {
+            if (convFlags & CONV_FLAGS_888)
+                cpFlags |= CP_FLAGS_24BPP;
+            else if (convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444 | CONV_FLAGS_8332 | CONV_FLAGS_A8P8 | CONV_FLAGS_L16 | CONV_FLAGS_A8L8))
+                cpFlags |= CP_FLAGS_16BPP;
+            else if (convFlags & (CONV_FLAGS_44 | CONV_FLAGS_332 | CONV_FLAGS_PAL8 | CONV_FLAGS_L8))
+                cpFlags |= CP_FLAGS_8BPP;
+        }
+
+        return cpFlags;
+    }
+
     //-------------------------------------------------------------------------------------
     // Converts or copies image data from pPixels into scratch image data
     //-------------------------------------------------------------------------------------
@@ -1237,15 +1473,7 @@ namespace
         if (!size)
             return E_FAIL;
 
-        if (convFlags & CONV_FLAGS_EXPAND)
-        {
-            if (convFlags & CONV_FLAGS_888)
-                cpFlags |= CP_FLAGS_24BPP;
-            else if (convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444 | CONV_FLAGS_8332 | CONV_FLAGS_A8P8 | CONV_FLAGS_L16 | CONV_FLAGS_A8L8))
-                cpFlags |= CP_FLAGS_16BPP;
-            else if (convFlags & (CONV_FLAGS_44 | CONV_FLAGS_332 | CONV_FLAGS_PAL8 | CONV_FLAGS_L8))
-                cpFlags |= CP_FLAGS_8BPP;
-        }
+        cpFlags = GetSourcePitchFlags(cpFlags, convFlags);
 
         size_t pixelSize, nimages;
         if (!_DetermineImageArray(metadata, cpFlags, nimages, pixelSize))
@@ -1355,41 +1583,9 @@ namespace
                     }
                     else
                     {
-                        for (size_t h = 0; h < images[index].height; ++h)
-                        {
-                            if (convFlags & CONV_FLAGS_EXPAND)
-                            {
-                                if (convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444))
-                                {
-                                    if (!_ExpandScanline(pDest, dpitch, DXGI_FORMAT_R8G8B8A8_UNORM,
-                                        pSrc, spitch,
-                                        (convFlags & CONV_FLAGS_565) ? DXGI_FORMAT_B5G6R5_UNORM : DXGI_FORMAT_B5G5R5A1_UNORM,
-                                        tflags))
-                                        return E_FAIL;
-                                }
-                                else
-                                {
-                                    TEXP_LEGACY_FORMAT lformat = _FindLegacyFormat(convFlags);
-                                    if (!LegacyExpandScanline(pDest, dpitch, metadata.format,
-                                        pSrc, spitch, lformat, pal8,
-                                        tflags))
-                                        return E_FAIL;
-                                }
-                            }
-                            else if (convFlags & CONV_FLAGS_SWIZZLE)
-                            {
-                                _SwizzleScanline(pDest, dpitch, pSrc, spitch,
-                                    metadata.format, tflags);
-                            }
-                            else
-                            {
-                                _CopyScanline(pDest, dpitch, pSrc, spitch,
-                                    metadata.format, tflags);
-                            }
-
-                            pSrc += spitch;
-                            pDest += dpitch;
-                        }
+                        HRESULT hr = ConvertRows(pDest, dpitch, pSrc, spitch, images[index].height, metadata.format, convFlags, pal8, tflags);
+                        if (FAILED(hr))
+                            return hr;
                     }
                 }
             }
@@ -1448,39 +1644,9 @@ namespace
                     }
                     else
                     {
-                        for (size_t h = 0; h < images[index].height; ++h)
-                        {
-                            if (convFlags & CONV_FLAGS_EXPAND)
-                            {
-                                if (convFlags & (CONV_FLAGS_565 | CONV_FLAGS_5551 | CONV_FLAGS_4444))
-                                {
-                                    if (!_ExpandScanline(pDest, dpitch, DXGI_FORMAT_R8G8B8A8_UNORM,
-                                        pSrc, spitch,
-                                        (convFlags & CONV_FLAGS_565) ? DXGI_FORMAT_B5G6R5_UNORM : DXGI_FORMAT_B5G5R5A1_UNORM,
-                                        tflags))
-                                        return E_FAIL;
-                                }
-                                else
-                                {
-                                    TEXP_LEGACY_FORMAT lformat = _FindLegacyFormat(convFlags);
-                                    if (!LegacyExpandScanline(pDest, dpitch, metadata.format,
-                                        pSrc, spitch, lformat, pal8,
-                                        tflags))
-                                        return E_FAIL;
-                                }
-                            }
-                            else if (convFlags & CONV_FLAGS_SWIZZLE)
-                            {
-                                _SwizzleScanline(pDest, dpitch, pSrc, spitch, metadata.format, tflags);
-                            }
-                            else
-                            {
-                                _CopyScanline(pDest, dpitch, pSrc, spitch, metadata.format, tflags);
-                            }
-
-                            pSrc += spitch;
-                            pDest += dpitch;
-                        }
+                        HRESULT hr = ConvertRows(pDest, dpitch, pSrc, spitch, images[index].height, metadata.format, convFlags, pal8, tflags);
+                        if (FAILED(hr))
+                            return hr;
                     }
                 }
 
@@ -1541,93 +1707,853 @@ namespace
 
         return S_OK;
     }
-}
 
+    //-------------------------------------------------------------------------------------
+    // Loads pixel data through a file mapping (DDS_FLAGS_MAPPED_FILE)
+    //-------------------------------------------------------------------------------------
+    HRESULT LoadMappedImage(
+        _In_ HANDLE hFile,
+        _In_ uint64_t fileSize,
+        _In_ size_t offset,
+        _In_ const TexMetadata& metadata,
+        _In_ DDS_FLAGS flags,
+        _In_ uint32_t convFlags,
+        _In_reads_opt_(256) const uint32_t *pal8,
+        _Out_ ScratchImage& image) noexcept
+    {
+    #if !defined(WINAPI_FAMILY) || (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+        if (fileSize > SIZE_MAX)
+            return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
 
-//=====================================================================================
-// Entry-points
-//=====================================================================================
+        const bool copy = (convFlags & CONV_FLAGS_EXPAND) || (flags & (DDS_FLAGS_LEGACY_DWORD | DDS_FLAGS_BAD_DXTN_TAILS));
+        const bool inPlace = !copy && (convFlags & (CONV_FLAGS_SWIZZLE | CONV_FLAGS_NOALPHA));
 
-//-------------------------------------------------------------------------------------
-// Obtain metadata from DDS file in memory/on disk
-//-------------------------------------------------------------------------------------
+        // The view base is allocation-granularity aligned, so only the header size decides pixel alignment
+        if (!copy && (offset & 0xF) && BitsPerPixel(metadata.format) >= 128)
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
 
-_Use_decl_annotations_
-HRESULT DirectX::GetMetadataFromDDSMemory(
-    const void* pSource,
-    size_t size,
-    DDS_FLAGS flags,
-    TexMetadata& metadata) noexcept
-{
-    if (!pSource || size == 0)
-        return E_INVALIDARG;
+        ScopedHandle hMapping(CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr));
+        if (!hMapping)
+            return HRESULT_FROM_WIN32(GetLastError());
 
-    uint32_t convFlags = 0;
-    return DecodeDDSHeader(pSource, size, flags, metadata, convFlags);
-}
+        // The view is private copy-on-write, so swizzling or any later in-place edit of the image leaves the file untouched
+        auto view = static_cast<uint8_t*>(MapViewOfFile(hMapping.get(), FILE_MAP_COPY, 0, 0, 0));
+        if (!view)
+            return HRESULT_FROM_WIN32(GetLastError());
 
-_Use_decl_annotations_
-HRESULT DirectX::GetMetadataFromDDSFile(
-    const wchar_t* szFile,
-    DDS_FLAGS flags,
-    TexMetadata& metadata) noexcept
-{
-    if (!szFile)
-        return E_INVALIDARG;
+        const auto viewSize = static_cast<size_t>(fileSize);
 
-#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
-    ScopedHandle hFile(safe_handle(CreateFile2(szFile, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr)));
-#else
-    ScopedHandle hFile(safe_handle(CreateFileW(szFile, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
-        FILE_FLAG_SEQUENTIAL_SCAN, nullptr)));
-#endif
-    if (!hFile)
-    {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
+        if (copy)
+        {
+            // Expand straight from the view rather than staging the file in a temporary buffer
+            CP_FLAGS cflags = CP_FLAGS_NONE;
+            if (flags & DDS_FLAGS_LEGACY_DWORD)
+            {
+                cflags |= CP_FLAGS_LEGACY_DWORD;
+            }
+            if (flags & DDS_FLAGS_BAD_DXTN_TAILS)
+            {
+                cflags |= CP_FLAGS_BAD_DXTN_TAILS;
+            }
 
-    // Get the file size
-    FILE_STANDARD_INFO fileInfo;
-    if (!GetFileInformationByHandleEx(hFile.get(), FileStandardInfo, &fileInfo, sizeof(fileInfo)))
-    {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
+            HRESULT hr = image.Initialize(metadata);
+            if (SUCCEEDED(hr))
+            {
+                hr = CopyImage(view + offset, viewSize - offset, metadata, cflags, convFlags, pal8, image);
+                if (FAILED(hr))
+                    image.Release();
+            }
 
-    // File is too big for 32-bit allocation, so reject read (4 GB should be plenty large enough for a valid DDS file)
-    if (fileInfo.EndOfFile.HighPart > 0)
-    {
-        return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+            (void)UnmapViewOfFile(view);
+            return hr;
+        }
+
+        HRESULT hr = image.AttachMappedView(metadata, view, offset, viewSize);
+        if (FAILED(hr))
+        {
+            (void)UnmapViewOfFile(view);
+            return (hr == HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER)) ? HRESULT_FROM_WIN32(ERROR_HANDLE_EOF) : hr;
+        }
+
+        if (inPlace)
+        {
+            hr = CopyImageInPlace(convFlags, image);
+            if (FAILED(hr))
+            {
+                image.Release();
+                return hr;
+            }
+        }
+
+        return S_OK;
+    #else
+        UNREFERENCED_PARAMETER(hFile);
+        UNREFERENCED_PARAMETER(fileSize);
+        UNREFERENCED_PARAMETER(offset);
+        UNREFERENCED_PARAMETER(metadata);
+        UNREFERENCED_PARAMETER(flags);
+        UNREFERENCED_PARAMETER(convFlags);
+        UNREFERENCED_PARAMETER(pal8);
+        UNREFERENCED_PARAMETER(image);
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    #endif
     }
 
-    // Need at least enough data to fill the standard header and magic number to be a valid DDS
-    if (fileInfo.EndOfFile.LowPart < (sizeof(DDS_HEADER) + sizeof(uint32_t)))
+    //-------------------------------------------------------------------------------------
+    // Reads the header (and palette) of a DDS file, leaving the file positioned at the pixel data
+    //-------------------------------------------------------------------------------------
+    HRESULT ReadDDSFileHeader(
+        _In_ HANDLE hFile,
+        _In_ DDS_FLAGS flags,
+        _Out_ uint64_t& fileSize,
+        _Out_ size_t& offset,
+        _Out_ TexMetadata& metadata,
+        _Out_ uint32_t& convFlags,
+        _Inout_ std::unique_ptr<uint32_t[]>& pal8) noexcept
     {
-        return E_FAIL;
-    }
+        fileSize = 0;
+        offset = 0;
+        convFlags = 0;
 
-    // Read the header in (including extended header if present)
-    const size_t MAX_HEADER_SIZE = sizeof(uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
-    uint8_t header[MAX_HEADER_SIZE] = {};
+        // Get the file size
+        FILE_STANDARD_INFO fileInfo;
+        if (!GetFileInformationByHandleEx(hFile, FileStandardInfo, &fileInfo, sizeof(fileInfo)))
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
 
-    DWORD bytesRead = 0;
-    if (!ReadFile(hFile.get(), header, MAX_HEADER_SIZE, &bytesRead, nullptr))
-    {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
+        // Files of 4 GB or more are only read with DDS_FLAGS_ALLOW_LARGE_FILES, and never beyond the address space
+        if (fileInfo.EndOfFile.HighPart > 0)
+        {
+        #if defined(_WIN64)
+            if (!(flags & DDS_FLAGS_ALLOW_LARGE_FILES))
+        #endif
+            {
+                return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+            }
+        }
 
-    uint32_t convFlags = 0;
-    return DecodeDDSHeader(header, bytesRead, flags, metadata, convFlags);
-}
+        // Need at least enough data to fill the standard header and magic number to be a valid DDS
+        if (fileInfo.EndOfFile.QuadPart < static_cast<LONGLONG>(sizeof(DDS_HEADER) + sizeof(uint32_t)))
+        {
+            return E_FAIL;
+        }
 
+        // Read the header in (including extended header if present)
+        const size_t MAX_HEADER_SIZE = sizeof(uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
+        uint8_t header[MAX_HEADER_SIZE] = {};
 
-//-------------------------------------------------------------------------------------
-// Load a DDS file in memory
-//-------------------------------------------------------------------------------------
-_Use_decl_annotations_
-HRESULT DirectX::LoadFromDDSMemory(
-    const void* pSource,
-    size_t size,
-    DDS_FLAGS flags,
+        DWORD bytesRead = 0;
+        if (!ReadFile(hFile, header, MAX_HEADER_SIZE, &bytesRead, nullptr))
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        HRESULT hr = DecodeDDSHeader(header, bytesRead, flags, metadata, convFlags);
+        if (FAILED(hr))
+            return hr;
+
+        offset = MAX_HEADER_SIZE;
+
+        if (!(convFlags & CONV_FLAGS_DX10))
+        {
+            // Must reset file position since we read more than the standard header above
+            LARGE_INTEGER filePos = { { sizeof(uint32_t) + sizeof(DDS_HEADER), 0 } };
+            if (!SetFilePointerEx(hFile, filePos, nullptr, FILE_BEGIN))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            offset = sizeof(uint32_t) + sizeof(DDS_HEADER);
+        }
+
+        if (convFlags & CONV_FLAGS_PAL8)
+        {
+            pal8.reset(new (std::nothrow) uint32_t[256]);
+            if (!pal8)
+            {
+                return E_OUTOFMEMORY;
+            }
+
+            if (!ReadFile(hFile, pal8.get(), 256 * sizeof(uint32_t), &bytesRead, nullptr))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            if (bytesRead != (256 * sizeof(uint32_t)))
+            {
+                return E_FAIL;
+            }
+
+            offset += (256 * sizeof(uint32_t));
+        }
+
+        fileSize = static_cast<uint64_t>(fileInfo.EndOfFile.QuadPart);
+
+        return S_OK;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Reads bytes from an absolute file position
+    //-------------------------------------------------------------------------------------
+    constexpr size_t DDS_IO_CHUNK = 0x40000000;
+        // Largest single ReadFile/WriteFile request
+
+    HRESULT ReadFileAt(_In_ HANDLE hFile, _In_ uint64_t position, _Out_writes_bytes_(bytes) void* pDest, _In_ size_t bytes) noexcept
+    {
+        LARGE_INTEGER filePos;
+        filePos.QuadPart = static_cast<LONGLONG>(position);
+        if (!SetFilePointerEx(hFile, filePos, nullptr, FILE_BEGIN))
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        auto ptr = static_cast<uint8_t*>(pDest);
+        while (bytes > 0)
+        {
+            auto chunk = static_cast<DWORD>(std::min<size_t>(bytes, DDS_IO_CHUNK));
+
+            DWORD bytesRead = 0;
+            if (!ReadFile(hFile, ptr, chunk, &bytesRead, nullptr))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            if (bytesRead != chunk)
+            {
+                return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+            }
+
+            ptr += chunk;
+            bytes -= chunk;
+        }
+
+        return S_OK;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Reads a large span as several stripes, each through its own handle (DDS_FLAGS_STRIPED_READ)
+    //-------------------------------------------------------------------------------------
+    constexpr size_t DDS_STRIPE_MIN = 0x10000000;
+        // Smallest span which is split across concurrent readers
+
+    constexpr size_t DDS_STRIPE_MAX_STREAMS = 4;
+        // More outstanding sequential streams than this no longer adds bandwidth
+
+    HRESULT ReadFileStriped(
+        _In_z_ const wchar_t* szFile,
+        _In_ HANDLE hFile,
+        _In_ uint64_t position,
+        _Out_writes_bytes_(bytes) void* pDest,
+        _In_ size_t bytes) noexcept
+    {
+    #ifdef _OPENMP
+        size_t streams = 1;
+        if (!omp_in_parallel())
+        {
+            streams = std::min<size_t>(static_cast<size_t>(std::max(omp_get_max_threads(), 1)), DDS_STRIPE_MAX_STREAMS);
+            streams = std::min<size_t>(streams, bytes / DDS_STRIPE_MIN);
+        }
+
+        if (streams > 1)
+        {
+            // Stripes stay 64K aligned so each reader issues large, sequential requests
+            const size_t stripe = ((bytes + streams - 1) / streams + 0xFFFF) & ~size_t(0xFFFF);
+
+            bool fail = false;
+            HRESULT result = S_OK;
+
+            #pragma omp parallel for num_threads(static_cast<int>(streams))
+            for (int s = 0; s < static_cast<int>(streams); ++s)
+            {
+                const size_t start = static_cast<size_t>(s) * stripe;
+                if (start >= bytes)
+                    continue;
+
+                const size_t count = std::min(stripe, bytes - start);
+                auto ptr = static_cast<uint8_t*>(pDest) + start;
+
+                HRESULT hr;
+                if (!s)
+                {
+                    hr = ReadFileAt(hFile, position + start, ptr, count);
+                }
+                else
+                {
+                #if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+                    ScopedHandle hStripe(safe_handle(CreateFile2(szFile, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr)));
+                #else
+                    ScopedHandle hStripe(safe_handle(CreateFileW(szFile, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                        FILE_FLAG_SEQUENTIAL_SCAN, nullptr)));
+                #endif
+                    hr = (hStripe) ? ReadFileAt(hStripe.get(), position + start, ptr, count) : HRESULT_FROM_WIN32(GetLastError());
+                }
+
+                if (FAILED(hr))
+                {
+                    #pragma omp critical
+                    {
+                        if (!fail)
+                            result = hr;
+                        fail = true;
+                    }
+                }
+            }
+
+            return result;
+        }
+    #else
+        UNREFERENCED_PARAMETER(szFile);
+    #endif
+
+        return ReadFileAt(hFile, position, pDest, bytes);
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Reads uncompressed pixel data in bands of rows, converting each band straight into
+    // the scratch image rather than staging the whole file
+    //-------------------------------------------------------------------------------------
+    constexpr size_t DDS_CONVERT_BAND = 0x1000000;
+        // Source bytes read per band when converting legacy pixel data
+
+    HRESULT ReadConvertedImage(
+        _In_ HANDLE hFile,
+        _In_ uint64_t position,
+        _In_ size_t remaining,
+        _In_ const TexMetadata& metadata,
+        _In_ CP_FLAGS cpFlags,
+        _In_ uint32_t convFlags,
+        _In_reads_opt_(256) const uint32_t* pal8,
+        _In_ const ScratchImage& image) noexcept
+    {
+        assert(!IsCompressed(metadata.format) && !IsPlanar(metadata.format));
+
+        const Image* images = image.GetImages();
+        const size_t nimages = image.GetImageCount();
+        if (!images || !nimages)
+            return E_FAIL;
+
+        cpFlags = GetSourcePitchFlags(cpFlags, convFlags);
+
+        // Validate the source layout against the file size before reading anything
+        uint64_t total = 0;
+        size_t maxPitch = 0;
+        for (size_t index = 0; index < nimages; ++index)
+        {
+            if (!images[index].pixels)
+                return E_POINTER;
+
+            size_t spitch, sslice;
+            HRESULT hr = ComputePitch(metadata.format, images[index].width, images[index].height, spitch, sslice, cpFlags);
+            if (FAILED(hr))
+                return hr;
+
+            total += sslice;
+            maxPitch = std::max(maxPitch, spitch);
+        }
+
+        if (total > remaining)
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+
+        const size_t bufferSize = std::max(maxPitch, static_cast<size_t>(std::min<uint64_t>(total, DDS_CONVERT_BAND)));
+        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[bufferSize]);
+        if (!temp)
+            return E_OUTOFMEMORY;
+
+        uint32_t tflags = (convFlags & CONV_FLAGS_NOALPHA) ? TEXP_SCANLINE_SETALPHA : 0u;
+        if (convFlags & CONV_FLAGS_SWIZZLE)
+            tflags |= TEXP_SCANLINE_LEGACY;
+
+        for (size_t index = 0; index < nimages; ++index)
+        {
+            size_t spitch, sslice;
+            HRESULT hr = ComputePitch(metadata.format, images[index].width, images[index].height, spitch, sslice, cpFlags);
+            if (FAILED(hr))
+                return hr;
+
+            const size_t dpitch = images[index].rowPitch;
+            const size_t bandRows = std::max<size_t>(1, bufferSize / spitch);
+
+            uint8_t* pDest = images[index].pixels;
+            for (size_t y = 0; y < images[index].height; )
+            {
+                const size_t rows = std::min(bandRows, images[index].height - y);
+
+                hr = ReadFileAt(hFile, position, temp.get(), rows * spitch);
+                if (FAILED(hr))
+                    return hr;
+
+                hr = ConvertRows(pDest, dpitch, temp.get(), spitch, rows, metadata.format, convFlags, pal8, tflags);
+                if (FAILED(hr))
+                    return hr;
+
+                position += rows * spitch;
+                pDest += rows * dpitch;
+                y += rows;
+            }
+        }
+
+        return S_OK;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Writes bytes at the current file position
+    //-------------------------------------------------------------------------------------
+    HRESULT WriteFileChunked(_In_ HANDLE hFile, _In_reads_bytes_(bytes) const void* pSource, _In_ size_t bytes) noexcept
+    {
+        auto ptr = static_cast<const uint8_t*>(pSource);
+        while (bytes > 0)
+        {
+            auto chunk = static_cast<DWORD>(std::min<size_t>(bytes, DDS_IO_CHUNK));
+
+            DWORD bytesWritten = 0;
+            if (!WriteFile(hFile, ptr, chunk, &bytesWritten, nullptr))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            if (bytesWritten != chunk)
+            {
+                return E_FAIL;
+            }
+
+            ptr += chunk;
+            bytes -= chunk;
+        }
+
+        return S_OK;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Gathers the header, rows and small subresources into a few large writes
+    //-------------------------------------------------------------------------------------
+    constexpr size_t DDS_SECTOR_SIZE = 4096;
+        // Unbuffered I/O granularity (a multiple of both 512e and 4Kn sector sizes)
+
+    constexpr size_t DDS_STAGING_SIZE = 0x400000;
+        // Gather buffer size; spans at least this large bypass it in buffered mode
+
+    class DDSWriteStage
+    {
+    public:
+        DDSWriteStage(_In_ HANDLE hFile, bool unbuffered) noexcept :
+            m_hFile(hFile),
+            m_unbuffered(unbuffered),
+            m_used(0),
+            m_written(0)
+        {
+        }
+
+        DDSWriteStage(const DDSWriteStage&) = delete;
+        DDSWriteStage& operator=(const DDSWriteStage&) = delete;
+
+        HRESULT Initialize() noexcept
+        {
+            m_staging.reset(static_cast<uint8_t*>(_AlignedAlloc(DDS_STAGING_SIZE, DDS_SECTOR_SIZE)));
+            return (m_staging) ? S_OK : E_OUTOFMEMORY;
+        }
+
+        HRESULT Write(_In_reads_bytes_(bytes) const void* pSource, size_t bytes) noexcept
+        {
+            auto ptr = static_cast<const uint8_t*>(pSource);
+
+            if (!m_unbuffered && bytes >= DDS_STAGING_SIZE)
+            {
+                // Large contiguous spans go straight to the file after whatever is pending
+                HRESULT hr = Drain();
+                if (FAILED(hr))
+                    return hr;
+
+                hr = WriteFileChunked(m_hFile, ptr, bytes);
+                if (FAILED(hr))
+                    return hr;
+
+                m_written += bytes;
+                return S_OK;
+            }
+
+            while (bytes > 0)
+            {
+                const size_t count = std::min(bytes, DDS_STAGING_SIZE - m_used);
+                memcpy(m_staging.get() + m_used, ptr, count);
+                m_used += count;
+                ptr += count;
+                bytes -= count;
+
+                if (m_used == DDS_STAGING_SIZE)
+                {
+                    HRESULT hr = Drain();
+                    if (FAILED(hr))
+                        return hr;
+                }
+            }
+
+            return S_OK;
+        }
+
+        // Writes out any pending bytes; unbuffered output is padded to a whole sector and then trimmed
+        HRESULT Finish() noexcept
+        {
+            if (!m_unbuffered || !m_used)
+                return Drain();
+
+            const uint64_t total = m_written + m_used;
+
+            const size_t padded = (m_used + DDS_SECTOR_SIZE - 1) & ~(DDS_SECTOR_SIZE - 1);
+            memset(m_staging.get() + m_used, 0, padded - m_used);
+            m_used = padded;
+
+            HRESULT hr = Drain();
+            if (FAILED(hr))
+                return hr;
+
+            FILE_END_OF_FILE_INFO info = {};
+            info.EndOfFile.QuadPart = static_cast<LONGLONG>(total);
+            if (!SetFileInformationByHandle(m_hFile, FileEndOfFileInfo, &info, sizeof(info)))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            m_written = total;
+            return S_OK;
+        }
+
+    private:
+        HRESULT Drain() noexcept
+        {
+            if (!m_used)
+                return S_OK;
+
+            HRESULT hr = WriteFileChunked(m_hFile, m_staging.get(), m_used);
+            if (FAILED(hr))
+                return hr;
+
+            m_written += m_used;
+            m_used = 0;
+            return S_OK;
+        }
+
+        HANDLE                                      m_hFile;
+        bool                                        m_unbuffered;
+        std::unique_ptr<uint8_t[], aligned_deleter> m_staging;
+        size_t                                      m_used;
+        uint64_t                                    m_written;
+    };
+
+    //-------------------------------------------------------------------------------------
+    // Writes one subresource using the DDS (byte aligned) pitch
+    //-------------------------------------------------------------------------------------
+    HRESULT WriteDDSImage(DDSWriteStage& stage, _In_ const Image& image, _In_ DXGI_FORMAT format) noexcept
+    {
+        if (!image.pixels)
+            return E_POINTER;
+
+        assert(image.rowPitch > 0);
+        assert(image.slicePitch > 0);
+
+        size_t ddsRowPitch, ddsSlicePitch;
+        HRESULT hr = ComputePitch(format, image.width, image.height, ddsRowPitch, ddsSlicePitch, CP_FLAGS_NONE);
+        if (FAILED(hr))
+            return hr;
+
+        if (image.slicePitch == ddsSlicePitch)
+            return stage.Write(image.pixels, ddsSlicePitch);
+
+        size_t rowPitch = image.rowPitch;
+        if (rowPitch < ddsRowPitch)
+        {
+            // DDS uses 1-byte alignment, so if this is happening then the input pitch isn't actually a full line of data
+            return E_FAIL;
+        }
+
+        const uint8_t * __restrict sPtr = image.pixels;
+
+        size_t lines = ComputeScanlines(format, image.height);
+        for (size_t j = 0; j < lines; ++j)
+        {
+            hr = stage.Write(sPtr, ddsRowPitch);
+            if (FAILED(hr))
+                return hr;
+
+            sPtr += rowPitch;
+        }
+
+        return S_OK;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Shape and file placement of a mip/item subset
+    //-------------------------------------------------------------------------------------
+    struct DDSSubset
+    {
+        TexMetadata metadata;   // Shape of the returned image
+        size_t      itemStart;
+        size_t      itemStride; // Bytes per item in the file
+        size_t      mipOffset;  // Bytes before the first selected mip within an item
+        size_t      mipBytes;   // Bytes of the selected mips within an item
+    };
+
+    HRESULT ComputeDDSSubset(
+        _In_ const TexMetadata& metadata,
+        _In_ CP_FLAGS cpFlags,
+        _In_ size_t mipStart,
+        _In_ size_t mipCount,
+        _In_ size_t itemStart,
+        _In_ size_t itemCount,
+        _Out_ DDSSubset& subset) noexcept
+    {
+        memset(&subset, 0, sizeof(subset));
+
+        if (mipStart >= metadata.mipLevels || itemStart >= metadata.arraySize)
+            return E_INVALIDARG;
+
+        if (!mipCount)
+            mipCount = metadata.mipLevels - mipStart;
+
+        if (!itemCount)
+            itemCount = metadata.arraySize - itemStart;
+
+        if (mipCount > metadata.mipLevels - mipStart || itemCount > metadata.arraySize - itemStart)
+            return E_INVALIDARG;
+
+        uint64_t itemStride = 0;
+        uint64_t mipOffset = 0;
+        uint64_t mipBytes = 0;
+
+        size_t width = metadata.width;
+        size_t height = metadata.height;
+        size_t depth = metadata.depth;
+
+        for (size_t level = 0; level < metadata.mipLevels; ++level)
+        {
+            size_t rowPitch, slicePitch;
+            HRESULT hr = ComputePitch(metadata.format, width, height, rowPitch, slicePitch, cpFlags);
+            if (FAILED(hr))
+                return hr;
+
+            const uint64_t levelBytes = uint64_t(slicePitch) * uint64_t(depth);
+            if (level < mipStart)
+                mipOffset += levelBytes;
+            else if (level < mipStart + mipCount)
+                mipBytes += levelBytes;
+
+            itemStride += levelBytes;
+
+            if (width > 1)
+                width >>= 1;
+
+            if (height > 1)
+                height >>= 1;
+
+            if (depth > 1)
+                depth >>= 1;
+        }
+
+        if (itemStride > SIZE_MAX / metadata.arraySize)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        subset.metadata = metadata;
+        subset.metadata.width = std::max<size_t>(1, metadata.width >> mipStart);
+        subset.metadata.height = std::max<size_t>(1, metadata.height >> mipStart);
+        subset.metadata.depth = std::max<size_t>(1, metadata.depth >> mipStart);
+        subset.metadata.mipLevels = mipCount;
+        subset.metadata.arraySize = itemCount;
+
+        if (metadata.IsCubemap() && ((itemStart % 6) != 0 || (itemCount % 6) != 0))
+        {
+            // A partial cube is returned as a plain 2D array
+            subset.metadata.miscFlags &= ~static_cast<uint32_t>(TEX_MISC_TEXTURECUBE);
+        }
+
+        subset.itemStart = itemStart;
+        subset.itemStride = static_cast<size_t>(itemStride);
+        subset.mipOffset = static_cast<size_t>(mipOffset);
+        subset.mipBytes = static_cast<size_t>(mipBytes);
+
+        return S_OK;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Loads a mip/item subset; read(position, dest, bytes) fetches pixel data relative to its start
+    //-------------------------------------------------------------------------------------
+    template<typename Reader>
+    HRESULT LoadDDSSubset(
+        Reader read,
+        _In_ size_t sourceSize,
+        _In_ const TexMetadata& metadata,
+        _In_ DDS_FLAGS flags,
+        _In_ uint32_t convFlags,
+        _In_reads_opt_(256) const uint32_t *pal8,
+        _In_ size_t mipStart,
+        _In_ size_t mipCount,
+        _In_ size_t itemStart,
+        _In_ size_t itemCount,
+        _Out_ ScratchImage& image) noexcept
+    {
+        CP_FLAGS cflags = CP_FLAGS_NONE;
+        if (flags & DDS_FLAGS_LEGACY_DWORD)
+        {
+            cflags |= CP_FLAGS_LEGACY_DWORD;
+        }
+        if (flags & DDS_FLAGS_BAD_DXTN_TAILS)
+        {
+            // Repairing the tail mips needs the last full-size block level, which an offset range may skip
+            if (mipStart > 0)
+                return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+            cflags |= CP_FLAGS_BAD_DXTN_TAILS;
+        }
+
+        DDSSubset subset;
+        HRESULT hr = ComputeDDSSubset(metadata, GetSourcePitchFlags(cflags, convFlags), mipStart, mipCount, itemStart, itemCount, subset);
+        if (FAILED(hr))
+            return hr;
+
+        const size_t items = subset.metadata.arraySize;
+        const uint64_t end = uint64_t(subset.itemStride) * uint64_t(itemStart + items - 1) + subset.mipOffset + subset.mipBytes;
+        if (end > sourceSize)
+            return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
+
+        hr = image.Initialize(subset.metadata);
+        if (FAILED(hr))
+            return hr;
+
+        if (!(convFlags & CONV_FLAGS_EXPAND) && cflags == CP_FLAGS_NONE)
+        {
+            // The selected mips of an item are contiguous in both the file and the image
+            for (size_t item = 0; item < items; ++item)
+            {
+                const Image* img = image.GetImage(0, item, 0);
+                if (!img)
+                    return E_UNEXPECTED;
+
+                hr = read(subset.itemStride * (itemStart + item) + subset.mipOffset, img->pixels, subset.mipBytes);
+                if (FAILED(hr))
+                    return hr;
+            }
+
+            if (convFlags & (CONV_FLAGS_SWIZZLE | CONV_FLAGS_NOALPHA))
+            {
+                // Swizzle/copy image in place
+                hr = CopyImageInPlace(convFlags, image);
+                if (FAILED(hr))
+                    return hr;
+            }
+        }
+        else
+        {
+            const size_t total = subset.mipBytes * items;
+
+            std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[total]);
+            if (!temp)
+                return E_OUTOFMEMORY;
+
+            for (size_t item = 0; item < items; ++item)
+            {
+                hr = read(subset.itemStride * (itemStart + item) + subset.mipOffset, temp.get() + subset.mipBytes * item, subset.mipBytes);
+                if (FAILED(hr))
+                    return hr;
+            }
+
+            hr = CopyImage(temp.get(), total, subset.metadata, cflags, convFlags, pal8, image);
+            if (FAILED(hr))
+                return hr;
+        }
+
+        return S_OK;
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Obtain metadata from DDS file in memory/on disk
+//-------------------------------------------------------------------------------------
+
+_Use_decl_annotations_
+HRESULT DirectX::GetMetadataFromDDSMemory(
+    const void* pSource,
+    size_t size,
+    DDS_FLAGS flags,
+    TexMetadata& metadata) noexcept
+{
+    if (!pSource || size == 0)
+        return E_INVALIDARG;
+
+    uint32_t convFlags = 0;
+    return DecodeDDSHeader(pSource, size, flags, metadata, convFlags);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GetMetadataFromDDSFile(
+    const wchar_t* szFile,
+    DDS_FLAGS flags,
+    TexMetadata& metadata) noexcept
+{
+    if (!szFile)
+        return E_INVALIDARG;
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    ScopedHandle hFile(safe_handle(CreateFile2(szFile, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr)));
+#else
+    ScopedHandle hFile(safe_handle(CreateFileW(szFile, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN, nullptr)));
+#endif
+    if (!hFile)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    // Get the file size
+    FILE_STANDARD_INFO fileInfo;
+    if (!GetFileInformationByHandleEx(hFile.get(), FileStandardInfo, &fileInfo, sizeof(fileInfo)))
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    // Files of 4 GB or more are only accepted with DDS_FLAGS_ALLOW_LARGE_FILES, and never beyond the address space
+    if (fileInfo.EndOfFile.HighPart > 0)
+    {
+    #if defined(_WIN64)
+        if (!(flags & DDS_FLAGS_ALLOW_LARGE_FILES))
+    #endif
+        {
+            return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+        }
+    }
+
+    // Need at least enough data to fill the standard header and magic number to be a valid DDS
+    if (fileInfo.EndOfFile.QuadPart < static_cast<LONGLONG>(sizeof(DDS_HEADER) + sizeof(uint32_t)))
+    {
+        return E_FAIL;
+    }
+
+    // Read the header in (including extended header if present)
+    const size_t MAX_HEADER_SIZE = sizeof(uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
+    uint8_t header[MAX_HEADER_SIZE] = {};
+
+    DWORD bytesRead = 0;
+    if (!ReadFile(hFile.get(), header, MAX_HEADER_SIZE, &bytesRead, nullptr))
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    uint32_t convFlags = 0;
+    return DecodeDDSHeader(header, bytesRead, flags, metadata, convFlags);
+}
+
+
+//-------------------------------------------------------------------------------------
+// Load a DDS file in memory
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::LoadFromDDSMemory(
+    const void* pSource,
+    size_t size,
+    DDS_FLAGS flags,
     TexMetadata* metadata,
     ScratchImage& image) noexcept
 {
@@ -1692,6 +2618,65 @@ HRESULT DirectX::LoadFromDDSMemory(
     return S_OK;
 }
 
+_Use_decl_annotations_
+HRESULT DirectX::LoadFromDDSMemory(
+    const void* pSource,
+    size_t size,
+    DDS_FLAGS flags,
+    size_t mipStart,
+    size_t mipCount,
+    size_t itemStart,
+    size_t itemCount,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    if (!pSource || size == 0)
+        return E_INVALIDARG;
+
+    image.Release();
+
+    uint32_t convFlags = 0;
+    TexMetadata mdata;
+    HRESULT hr = DecodeDDSHeader(pSource, size, flags, mdata, convFlags);
+    if (FAILED(hr))
+        return hr;
+
+    size_t offset = sizeof(uint32_t) + sizeof(DDS_HEADER);
+    if (convFlags & CONV_FLAGS_DX10)
+        offset += sizeof(DDS_HEADER_DXT10);
+
+    assert(offset <= size);
+
+    const uint32_t *pal8 = nullptr;
+    if (convFlags & CONV_FLAGS_PAL8)
+    {
+        pal8 = reinterpret_cast<const uint32_t*>(static_cast<const uint8_t*>(pSource) + offset);
+        assert(pal8);
+        offset += (256 * sizeof(uint32_t));
+        if (size < offset)
+            return E_FAIL;
+    }
+
+    auto pPixels = static_cast<const uint8_t*>(pSource) + offset;
+    hr = LoadDDSSubset(
+        [pPixels](size_t position, void* pDest, size_t bytes) noexcept -> HRESULT
+        {
+            memcpy(pDest, pPixels + position, bytes);
+            return S_OK;
+        },
+        size - offset, mdata, flags, convFlags, pal8, mipStart, mipCount, itemStart, itemCount, image);
+    if (FAILED(hr))
+    {
+        image.Release();
+        return hr;
+    }
+
+    if (metadata)
+        memcpy(metadata, &image.GetMetadata(), sizeof(TexMetadata));
+
+    return S_OK;
+}
+
 
 //-------------------------------------------------------------------------------------
 // Load a DDS file from disk
@@ -1720,104 +2705,69 @@ HRESULT DirectX::LoadFromDDSFile(
         return HRESULT_FROM_WIN32(GetLastError());
     }
 
-    // Get the file size
-    FILE_STANDARD_INFO fileInfo;
-    if (!GetFileInformationByHandleEx(hFile.get(), FileStandardInfo, &fileInfo, sizeof(fileInfo)))
-    {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
-
-    // File is too big for 32-bit allocation, so reject read (4 GB should be plenty large enough for a valid DDS file)
-    if (fileInfo.EndOfFile.HighPart > 0)
-    {
-        return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
-    }
-
-    // Need at least enough data to fill the standard header and magic number to be a valid DDS
-    if (fileInfo.EndOfFile.LowPart < (sizeof(DDS_HEADER) + sizeof(uint32_t)))
-    {
-        return E_FAIL;
-    }
-
-    // Read the header in (including extended header if present)
-    const size_t MAX_HEADER_SIZE = sizeof(uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
-    uint8_t header[MAX_HEADER_SIZE] = {};
-
-    DWORD bytesRead = 0;
-    if (!ReadFile(hFile.get(), header, MAX_HEADER_SIZE, &bytesRead, nullptr))
-    {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
-
+    uint64_t fileSize = 0;
+    size_t offset = 0;
     uint32_t convFlags = 0;
     TexMetadata mdata;
-    HRESULT hr = DecodeDDSHeader(header, bytesRead, flags, mdata, convFlags);
+    std::unique_ptr<uint32_t[]> pal8;
+    HRESULT hr = ReadDDSFileHeader(hFile.get(), flags, fileSize, offset, mdata, convFlags, pal8);
     if (FAILED(hr))
         return hr;
 
-    DWORD offset = MAX_HEADER_SIZE;
-
-    if (!(convFlags & CONV_FLAGS_DX10))
-    {
-        // Must reset file position since we read more than the standard header above
-        LARGE_INTEGER filePos = { { sizeof(uint32_t) + sizeof(DDS_HEADER), 0 } };
-        if (!SetFilePointerEx(hFile.get(), filePos, nullptr, FILE_BEGIN))
-        {
-            return HRESULT_FROM_WIN32(GetLastError());
-        }
-
-        offset = sizeof(uint32_t) + sizeof(DDS_HEADER);
-    }
+    auto remaining = static_cast<size_t>(fileSize - offset);
+    if (remaining == 0)
+        return E_FAIL;
 
-    std::unique_ptr<uint32_t[]> pal8;
-    if (convFlags & CONV_FLAGS_PAL8)
+    if (flags & DDS_FLAGS_MAPPED_FILE)
     {
-        pal8.reset(new (std::nothrow) uint32_t[256]);
-        if (!pal8)
+        hr = LoadMappedImage(hFile.get(), fileSize, offset, mdata, flags, convFlags, pal8.get(), image);
+        if (SUCCEEDED(hr))
         {
-            return E_OUTOFMEMORY;
-        }
+            if (metadata)
+                memcpy(metadata, &mdata, sizeof(TexMetadata));
 
-        if (!ReadFile(hFile.get(), pal8.get(), 256 * sizeof(uint32_t), &bytesRead, nullptr))
-        {
-            return HRESULT_FROM_WIN32(GetLastError());
+            return S_OK;
         }
 
-        if (bytesRead != (256 * sizeof(uint32_t)))
-        {
-            return E_FAIL;
-        }
+        if (hr != HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED))
+            return hr;
 
-        offset += (256 * sizeof(uint32_t));
+        // Fall back to reading the file
     }
 
-    DWORD remaining = fileInfo.EndOfFile.LowPart - offset;
-    if (remaining == 0)
-        return E_FAIL;
-
     hr = image.Initialize(mdata);
     if (FAILED(hr))
         return hr;
 
-    if ((convFlags & CONV_FLAGS_EXPAND) || (flags & (DDS_FLAGS_LEGACY_DWORD | DDS_FLAGS_BAD_DXTN_TAILS)))
+    if (((convFlags & CONV_FLAGS_EXPAND) || (flags & DDS_FLAGS_LEGACY_DWORD))
+        && !IsCompressed(mdata.format) && !IsPlanar(mdata.format))
     {
-        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[remaining]);
-        if (!temp)
+        // Convert in bands directly from the file without a full-size staging copy
+        hr = ReadConvertedImage(hFile.get(), offset, remaining, mdata,
+            (flags & DDS_FLAGS_LEGACY_DWORD) ? CP_FLAGS_LEGACY_DWORD : CP_FLAGS_NONE,
+            convFlags, pal8.get(), image);
+        if (FAILED(hr))
         {
             image.Release();
-            return E_OUTOFMEMORY;
+            return hr;
         }
-
-        if (!ReadFile(hFile.get(), temp.get(), remaining, &bytesRead, nullptr))
+    }
+    else if ((convFlags & CONV_FLAGS_EXPAND) || (flags & (DDS_FLAGS_LEGACY_DWORD | DDS_FLAGS_BAD_DXTN_TAILS)))
+    {
+        std::unique_ptr<uint8_t[]> temp(new (std::nothrow) uint8_t[remaining]);
+        if (!temp)
         {
             image.Release();
-            return HRESULT_FROM_WIN32(GetLastError());
+            return E_OUTOFMEMORY;
         }
 
-        if (bytesRead != remaining)
+        hr = (flags & DDS_FLAGS_STRIPED_READ)
+            ? ReadFileStriped(szFile, hFile.get(), offset, temp.get(), remaining)
+            : ReadFileAt(hFile.get(), offset, temp.get(), remaining);
+        if (FAILED(hr))
         {
             image.Release();
-            return E_FAIL;
+            return (hr == HRESULT_FROM_WIN32(ERROR_HANDLE_EOF)) ? E_FAIL : hr;
         }
 
         CP_FLAGS cflags = CP_FLAGS_NONE;
@@ -1851,32 +2801,86 @@ HRESULT DirectX::LoadFromDDSFile(
             return HRESULT_FROM_WIN32(ERROR_HANDLE_EOF);
         }
 
-        if (image.GetPixelsSize() > UINT32_MAX)
+        hr = (flags & DDS_FLAGS_STRIPED_READ)
+            ? ReadFileStriped(szFile, hFile.get(), offset, image.GetPixels(), image.GetPixelsSize())
+            : ReadFileAt(hFile.get(), offset, image.GetPixels(), image.GetPixelsSize());
+        if (FAILED(hr))
         {
             image.Release();
-            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+            return hr;
+        }
+
+        if (convFlags & (CONV_FLAGS_SWIZZLE | CONV_FLAGS_NOALPHA))
+        {
+            // Swizzle/copy image in place
+            hr = CopyImageInPlace(convFlags, image);
+            if (FAILED(hr))
+            {
+                image.Release();
+                return hr;
+            }
         }
+    }
+
+    if (metadata)
+        memcpy(metadata, &mdata, sizeof(TexMetadata));
+
+    return S_OK;
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::LoadFromDDSFile(
+    const wchar_t* szFile,
+    DDS_FLAGS flags,
+    size_t mipStart,
+    size_t mipCount,
+    size_t itemStart,
+    size_t itemCount,
+    TexMetadata* metadata,
+    ScratchImage& image) noexcept
+{
+    if (!szFile)
+        return E_INVALIDARG;
+
+    image.Release();
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    ScopedHandle hFile(safe_handle(CreateFile2(szFile, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr)));
+#else
+    ScopedHandle hFile(safe_handle(CreateFileW(szFile, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_FLAG_RANDOM_ACCESS, nullptr)));
+#endif
+
+    if (!hFile)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
 
-        if (!ReadFile(hFile.get(), image.GetPixels(), static_cast<DWORD>(image.GetPixelsSize()), &bytesRead, nullptr))
-        {
-            image.Release();
-            return HRESULT_FROM_WIN32(GetLastError());
-        }
+    uint64_t fileSize = 0;
+    size_t offset = 0;
+    uint32_t convFlags = 0;
+    TexMetadata mdata;
+    std::unique_ptr<uint32_t[]> pal8;
+    HRESULT hr = ReadDDSFileHeader(hFile.get(), flags, fileSize, offset, mdata, convFlags, pal8);
+    if (FAILED(hr))
+        return hr;
 
-        if (convFlags & (CONV_FLAGS_SWIZZLE | CONV_FLAGS_NOALPHA))
+    // Only the selected subresources are read, seeking past the rest
+    HANDLE handle = hFile.get();
+    hr = LoadDDSSubset(
+        [handle, offset](size_t position, void* pDest, size_t bytes) noexcept -> HRESULT
         {
-            // Swizzle/copy image in place
-            hr = CopyImageInPlace(convFlags, image);
-            if (FAILED(hr))
-            {
-                image.Release();
-                return hr;
-            }
-        }
+            return ReadFileAt(handle, uint64_t(offset) + position, pDest, bytes);
+        },
+        static_cast<size_t>(fileSize - offset), mdata, flags, convFlags, pal8.get(), mipStart, mipCount, itemStart, itemCount, image);
+    if (FAILED(hr))
+    {
+        image.Release();
+        return hr;
     }
 
     if (metadata)
-        memcpy(metadata, &mdata, sizeof(TexMetadata));
+        memcpy(metadata, &image.GetMetadata(), sizeof(TexMetadata));
 
     return S_OK;
 }
@@ -2133,10 +3137,17 @@ HRESULT DirectX::SaveToDDSFile(
         return hr;
 
     // Create file and write header
+    const bool unbuffered = (flags & DDS_FLAGS_WRITE_UNBUFFERED) != 0;
+
 #if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
-    ScopedHandle hFile(safe_handle(CreateFile2(szFile, GENERIC_WRITE | DELETE, 0, CREATE_ALWAYS, nullptr)));
+    CREATEFILE2_EXTENDED_PARAMETERS params = {};
+    params.dwSize = sizeof(CREATEFILE2_EXTENDED_PARAMETERS);
+    params.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+    params.dwFileFlags = (unbuffered) ? FILE_FLAG_NO_BUFFERING : 0;
+    ScopedHandle hFile(safe_handle(CreateFile2(szFile, GENERIC_WRITE | DELETE, 0, CREATE_ALWAYS, &params)));
 #else
-    ScopedHandle hFile(safe_handle(CreateFileW(szFile, GENERIC_WRITE | DELETE, 0, nullptr, CREATE_ALWAYS, 0, nullptr)));
+    ScopedHandle hFile(safe_handle(CreateFileW(szFile, GENERIC_WRITE | DELETE, 0, nullptr, CREATE_ALWAYS,
+        (unbuffered) ? FILE_FLAG_NO_BUFFERING : 0, nullptr)));
 #endif
     if (!hFile)
     {
@@ -2145,16 +3156,14 @@ HRESULT DirectX::SaveToDDSFile(
 
     auto_delete_file delonfail(hFile.get());
 
-    DWORD bytesWritten;
-    if (!WriteFile(hFile.get(), header, static_cast<DWORD>(required), &bytesWritten, nullptr))
-    {
-        return HRESULT_FROM_WIN32(GetLastError());
-    }
+    DDSWriteStage stage(hFile.get(), unbuffered);
+    hr = stage.Initialize();
+    if (FAILED(hr))
+        return hr;
 
-    if (bytesWritten != required)
-    {
-        return E_FAIL;
-    }
+    hr = stage.Write(header, required);
+    if (FAILED(hr))
+        return hr;
 
     // Write images
     switch (static_cast<DDS_RESOURCE_DIMENSION>(metadata.dimension))
@@ -2170,59 +3179,9 @@ HRESULT DirectX::SaveToDDSFile(
                 if (index >= nimages)
                     return E_FAIL;
 
-                if (!images[index].pixels)
-                    return E_POINTER;
-
-                assert(images[index].rowPitch > 0);
-                assert(images[index].slicePitch > 0);
-
-                size_t ddsRowPitch, ddsSlicePitch;
-                hr = ComputePitch(metadata.format, images[index].width, images[index].height, ddsRowPitch, ddsSlicePitch, CP_FLAGS_NONE);
+                hr = WriteDDSImage(stage, images[index], metadata.format);
                 if (FAILED(hr))
                     return hr;
-
-                if ((images[index].slicePitch == ddsSlicePitch) && (ddsSlicePitch <= UINT32_MAX))
-                {
-                    if (!WriteFile(hFile.get(), images[index].pixels, static_cast<DWORD>(ddsSlicePitch), &bytesWritten, nullptr))
-                    {
-                        return HRESULT_FROM_WIN32(GetLastError());
-                    }
-
-                    if (bytesWritten != ddsSlicePitch)
-                    {
-                        return E_FAIL;
-                    }
-                }
-                else
-                {
-                    size_t rowPitch = images[index].rowPitch;
-                    if (rowPitch < ddsRowPitch)
-                    {
-                        // DDS uses 1-byte alignment, so if this is happening then the input pitch isn't actually a full line of data
-                        return E_FAIL;
-                    }
-
-                    if (ddsRowPitch > UINT32_MAX)
-                        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
-
-                    const uint8_t * __restrict sPtr = images[index].pixels;
-
-                    size_t lines = ComputeScanlines(metadata.format, images[index].height);
-                    for (size_t j = 0; j < lines; ++j)
-                    {
-                        if (!WriteFile(hFile.get(), sPtr, static_cast<DWORD>(ddsRowPitch), &bytesWritten, nullptr))
-                        {
-                            return HRESULT_FROM_WIN32(GetLastError());
-                        }
-
-                        if (bytesWritten != ddsRowPitch)
-                        {
-                            return E_FAIL;
-                        }
-
-                        sPtr += rowPitch;
-                    }
-                }
             }
         }
     }
@@ -2243,72 +3202,281 @@ HRESULT DirectX::SaveToDDSFile(
                 if (index >= nimages)
                     return E_FAIL;
 
-                if (!images[index].pixels)
-                    return E_POINTER;
-
-                assert(images[index].rowPitch > 0);
-                assert(images[index].slicePitch > 0);
-
-                size_t ddsRowPitch, ddsSlicePitch;
-                hr = ComputePitch(metadata.format, images[index].width, images[index].height, ddsRowPitch, ddsSlicePitch, CP_FLAGS_NONE);
+                hr = WriteDDSImage(stage, images[index], metadata.format);
                 if (FAILED(hr))
                     return hr;
+            }
 
-                if ((images[index].slicePitch == ddsSlicePitch) && (ddsSlicePitch <= UINT32_MAX))
-                {
-                    if (!WriteFile(hFile.get(), images[index].pixels, static_cast<DWORD>(ddsSlicePitch), &bytesWritten, nullptr))
-                    {
-                        return HRESULT_FROM_WIN32(GetLastError());
-                    }
+            if (d > 1)
+                d >>= 1;
+        }
+    }
+    break;
 
-                    if (bytesWritten != ddsSlicePitch)
-                    {
-                        return E_FAIL;
-                    }
-                }
-                else
-                {
-                    size_t rowPitch = images[index].rowPitch;
-                    if (rowPitch < ddsRowPitch)
-                    {
-                        // DDS uses 1-byte alignment, so if this is happening then the input pitch isn't actually a full line of data
-                        return E_FAIL;
-                    }
+    default:
+        return E_FAIL;
+    }
+
+    hr = stage.Finish();
+    if (FAILED(hr))
+        return hr;
 
-                    if (ddsRowPitch > UINT32_MAX)
-                        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+    delonfail.clear();
 
-                    const uint8_t * __restrict sPtr = images[index].pixels;
+    return S_OK;
+}
 
-                    size_t lines = ComputeScanlines(metadata.format, images[index].height);
-                    for (size_t j = 0; j < lines; ++j)
-                    {
-                        if (!WriteFile(hFile.get(), sPtr, static_cast<DWORD>(ddsRowPitch), &bytesWritten, nullptr))
-                        {
-                            return HRESULT_FROM_WIN32(GetLastError());
-                        }
 
-                        if (bytesWritten != ddsRowPitch)
-                        {
-                            return E_FAIL;
-                        }
+//=====================================================================================
+// Streaming DDS writer
+//=====================================================================================
 
-                        sPtr += rowPitch;
-                    }
-                }
+struct DDSFileWriter::Impl
+{
+    Impl(_In_ HANDLE hFile, _In_ const TexMetadata& mdata, bool unbuffered) noexcept :
+        file(hFile),
+        delonfail(hFile),
+        stage(hFile, unbuffered),
+        metadata(mdata),
+        nimages(0),
+        index(0),
+        level(0),
+        slice(0),
+        depth(mdata.depth)
+    {
+    }
+
+    // Declared so the file is marked for deletion before the handle is closed
+    ScopedHandle        file;
+    auto_delete_file    delonfail;
+    DDSWriteStage       stage;
+    TexMetadata         metadata;
+    size_t              nimages;
+    size_t              index;
+    size_t              level;  // Position of the next image within the subresource order
+    size_t              slice;
+    size_t              depth;  // Depth of the current mip (3D)
+};
+
+DDSFileWriter::DDSFileWriter() noexcept
+{
+}
+
+DDSFileWriter::DDSFileWriter(DDSFileWriter&& moveFrom) noexcept :
+    m_impl(std::move(moveFrom.m_impl))
+{
+}
+
+DDSFileWriter::~DDSFileWriter()
+{
+}
+
+DDSFileWriter& DDSFileWriter::operator= (DDSFileWriter&& moveFrom) noexcept
+{
+    if (this != &moveFrom)
+    {
+        m_impl = std::move(moveFrom.m_impl);
+    }
+    return *this;
+}
+
+void DDSFileWriter::Release() noexcept
+{
+    m_impl.reset();
+}
+
+const TexMetadata& DDSFileWriter::GetMetadata() const noexcept
+{
+    static const TexMetadata s_empty = {};
+    return (m_impl) ? m_impl->metadata : s_empty;
+}
+
+size_t DDSFileWriter::GetImageCount() const noexcept
+{
+    return (m_impl) ? m_impl->nimages : 0;
+}
+
+size_t DDSFileWriter::GetImagesWritten() const noexcept
+{
+    return (m_impl) ? m_impl->index : 0;
+}
+
+_Use_decl_annotations_
+HRESULT DDSFileWriter::Create(const wchar_t* szFile, const TexMetadata& metadata, DDS_FLAGS flags) noexcept
+{
+    Release();
+
+    if (!szFile || !metadata.mipLevels)
+        return E_INVALIDARG;
+
+    size_t nimages = 0;
+    switch (metadata.dimension)
+    {
+    case TEX_DIMENSION_TEXTURE1D:
+    case TEX_DIMENSION_TEXTURE2D:
+        if (metadata.depth != 1 || metadata.arraySize < 1)
+            return E_INVALIDARG;
+
+        nimages = metadata.arraySize * metadata.mipLevels;
+        break;
+
+    case TEX_DIMENSION_TEXTURE3D:
+        if (metadata.arraySize != 1 || metadata.depth < 1)
+            return E_INVALIDARG;
+
+        {
+            size_t d = metadata.depth;
+            for (size_t level = 0; level < metadata.mipLevels; ++level)
+            {
+                nimages += d;
+
+                if (d > 1)
+                    d >>= 1;
             }
+        }
+        break;
 
-            if (d > 1)
-                d >>= 1;
+    default:
+        return E_INVALIDARG;
+    }
+
+    // Create DDS Header
+    const size_t MAX_HEADER_SIZE = sizeof(uint32_t) + sizeof(DDS_HEADER) + sizeof(DDS_HEADER_DXT10);
+    uint8_t header[MAX_HEADER_SIZE];
+    size_t required;
+    HRESULT hr = _EncodeDDSHeader(metadata, flags, header, MAX_HEADER_SIZE, required);
+    if (FAILED(hr))
+        return hr;
+
+    // Create file and write header
+    const bool unbuffered = (flags & DDS_FLAGS_WRITE_UNBUFFERED) != 0;
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    CREATEFILE2_EXTENDED_PARAMETERS params = {};
+    params.dwSize = sizeof(CREATEFILE2_EXTENDED_PARAMETERS);
+    params.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+    params.dwFileFlags = (unbuffered) ? FILE_FLAG_NO_BUFFERING : FILE_FLAG_SEQUENTIAL_SCAN;
+    ScopedHandle hFile(safe_handle(CreateFile2(szFile, GENERIC_WRITE | DELETE, 0, CREATE_ALWAYS, &params)));
+#else
+    ScopedHandle hFile(safe_handle(CreateFileW(szFile, GENERIC_WRITE | DELETE, 0, nullptr, CREATE_ALWAYS,
+        (unbuffered) ? FILE_FLAG_NO_BUFFERING : FILE_FLAG_SEQUENTIAL_SCAN, nullptr)));
+#endif
+    if (!hFile)
+    {
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
+
+    std::unique_ptr<Impl> impl;
+    {
+        auto_delete_file delonfail(hFile.get());
+
+        impl.reset(new (std::nothrow) Impl(hFile.get(), metadata, unbuffered));
+        if (!impl)
+            return E_OUTOFMEMORY;
+
+        delonfail.clear();
+    }
+
+    // The writer state owns the handle from here on
+    hFile.release();
+
+    impl->nimages = nimages;
+
+    hr = impl->stage.Initialize();
+    if (FAILED(hr))
+        return hr;
+
+    hr = impl->stage.Write(header, required);
+    if (FAILED(hr))
+        return hr;
+
+    m_impl = std::move(impl);
+
+    return S_OK;
+}
+
+_Use_decl_annotations_
+HRESULT DDSFileWriter::WriteImage(const Image& image) noexcept
+{
+    if (!m_impl)
+        return E_UNEXPECTED;
+
+    Impl& state = *m_impl;
+    const TexMetadata& mdata = state.metadata;
+
+    if (state.index >= state.nimages)
+        return E_FAIL;
+
+    // Each image must match the shape of the next subresource in the file
+    if (image.format != mdata.format
+        || image.width != std::max<size_t>(1, mdata.width >> state.level)
+        || image.height != std::max<size_t>(1, mdata.height >> state.level))
+    {
+        return E_INVALIDARG;
+    }
+
+    HRESULT hr = WriteDDSImage(state.stage, image, mdata.format);
+    if (FAILED(hr))
+    {
+        // The file contents are no longer well-formed
+        Release();
+        return hr;
+    }
+
+    ++state.index;
+
+    if (mdata.dimension == TEX_DIMENSION_TEXTURE3D)
+    {
+        if (++state.slice >= state.depth)
+        {
+            state.slice = 0;
+            ++state.level;
+
+            if (state.depth > 1)
+                state.depth >>= 1;
         }
     }
-    break;
+    else if (++state.level >= mdata.mipLevels)
+    {
+        state.level = 0;
+    }
 
-    default:
+    return S_OK;
+}
+
+_Use_decl_annotations_
+HRESULT DDSFileWriter::WriteImages(const Image* images, size_t nimages) noexcept
+{
+    if (!images || !nimages)
+        return E_INVALIDARG;
+
+    for (size_t index = 0; index < nimages; ++index)
+    {
+        HRESULT hr = WriteImage(images[index]);
+        if (FAILED(hr))
+            return hr;
+    }
+
+    return S_OK;
+}
+
+HRESULT DDSFileWriter::Commit() noexcept
+{
+    if (!m_impl)
+        return E_UNEXPECTED;
+
+    if (m_impl->index != m_impl->nimages)
         return E_FAIL;
+
+    HRESULT hr = m_impl->stage.Finish();
+    if (FAILED(hr))
+    {
+        Release();
+        return hr;
     }
 
-    delonfail.clear();
+    m_impl->delonfail.clear();
+    Release();
 
     return S_OK;
 }
@@ -333,40 +333,18 @@ namespace
     //-------------------------------------------------------------------------------------
     inline void HalfToRGBE(_Out_writes_(width * 4) uint8_t* pDestination, _In_reads_(width* fpp) const uint16_t* pSource, size_t width, _In_range_(3, 4) int fpp) noexcept
     {
-        auto ePtr = pSource + width * size_t(fpp);
+        // Expands a block of pixels at a time with the bulk converter, then encodes as floats
+        constexpr size_t CHUNK_PIXELS = 64;
+        float temp[CHUNK_PIXELS * 4];
 
-        for (size_t j = 0; j < width; ++j)
+        for (size_t j = 0; j < width; j += CHUNK_PIXELS)
         {
-            if (pSource + 2 >= ePtr) break;
-            float r = PackedVector::XMConvertHalfToFloat(pSource[0]); r = (r >= 0.f) ? r : 0.f;
-            float g = PackedVector::XMConvertHalfToFloat(pSource[1]); g = (g >= 0.f) ? g : 0.f;
-            float b = PackedVector::XMConvertHalfToFloat(pSource[2]); b = (b >= 0.f) ? b : 0.f;
-            pSource += fpp;
-
-            const float max_xy = (r > g) ? r : g;
-            float max_xyz = (max_xy > b) ? max_xy : b;
-
-            if (max_xyz > 1e-32f)
-            {
-                int e;
-                max_xyz = frexpf(max_xyz, &e) * 256.f / max_xyz;
-                e += 128;
-
-                uint8_t red = uint8_t(r * max_xyz);
-                uint8_t green = uint8_t(g * max_xyz);
-                uint8_t blue = uint8_t(b * max_xyz);
-
-                pDestination[0] = red;
-                pDestination[1] = green;
-                pDestination[2] = blue;
-                pDestination[3] = (red || green || blue) ? uint8_t(e & 0xff) : 0u;
-            }
-            else
-            {
-                pDestination[0] = pDestination[1] = pDestination[2] = pDestination[3] = 0;
-            }
+            const size_t count = std::min(CHUNK_PIXELS, width - j);
+            _ConvertHalfToFloatStream(temp, pSource, count * size_t(fpp));
+            FloatToRGBE(pDestination, temp, count, fpp);
 
-            pDestination += 4;
+            pSource += count * size_t(fpp);
+            pDestination += count * 4;
         }
     }
 
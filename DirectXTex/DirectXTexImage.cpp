@@ -265,14 +265,21 @@ ScratchImage& ScratchImage::operator= (ScratchImage&& moveFrom) noexcept
 
         m_nimages = moveFrom.m_nimages;
         m_size = moveFrom.m_size;
+        m_capacity = moveFrom.m_capacity;
         m_metadata = moveFrom.m_metadata;
         m_image = moveFrom.m_image;
         m_memory = moveFrom.m_memory;
+        m_allocator = moveFrom.m_allocator;
+        m_external = moveFrom.m_external;
+        m_mappedView = moveFrom.m_mappedView;
 
         moveFrom.m_nimages = 0;
         moveFrom.m_size = 0;
+        moveFrom.m_capacity = 0;
         moveFrom.m_image = nullptr;
         moveFrom.m_memory = nullptr;
+        moveFrom.m_external = false;
+        moveFrom.m_mappedView = nullptr;
     }
     return *this;
 }
@@ -328,7 +335,7 @@ HRESULT ScratchImage::Initialize(const TexMetadata& mdata, CP_FLAGS flags) noexc
         return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
     }
 
-    Release();
+    Recycle();
 
     m_metadata.width = mdata.width;
     m_metadata.height = mdata.height;
@@ -351,8 +358,7 @@ HRESULT ScratchImage::Initialize(const TexMetadata& mdata, CP_FLAGS flags) noexc
     m_nimages = nimages;
     memset(m_image, 0, sizeof(Image) * nimages);
 
-    m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, 16));
-    if (!m_memory)
+    if (!Reserve(pixelSize))
     {
         Release();
         return E_OUTOFMEMORY;
@@ -395,7 +401,7 @@ HRESULT ScratchImage::Initialize2D(DXGI_FORMAT fmt, size_t width, size_t height,
     if (!_CalculateMipLevels(width, height, mipLevels))
         return E_INVALIDARG;
 
-    Release();
+    Recycle();
 
     m_metadata.width = width;
     m_metadata.height = height;
@@ -418,8 +424,7 @@ HRESULT ScratchImage::Initialize2D(DXGI_FORMAT fmt, size_t width, size_t height,
     m_nimages = nimages;
     memset(m_image, 0, sizeof(Image) * nimages);
 
-    m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, 16));
-    if (!m_memory)
+    if (!Reserve(pixelSize))
     {
         Release();
         return E_OUTOFMEMORY;
@@ -446,7 +451,7 @@ HRESULT ScratchImage::Initialize3D(DXGI_FORMAT fmt, size_t width, size_t height,
     if (!_CalculateMipLevels3D(width, height, depth, mipLevels))
         return E_INVALIDARG;
 
-    Release();
+    Recycle();
 
     m_metadata.width = width;
     m_metadata.height = height;
@@ -471,8 +476,7 @@ HRESULT ScratchImage::Initialize3D(DXGI_FORMAT fmt, size_t width, size_t height,
     m_nimages = nimages;
     memset(m_image, 0, sizeof(Image) * nimages);
 
-    m_memory = static_cast<uint8_t*>(_aligned_malloc(pixelSize, 16));
-    if (!m_memory)
+    if (!Reserve(pixelSize))
     {
         Release();
         return E_OUTOFMEMORY;
@@ -677,7 +681,68 @@ HRESULT ScratchImage::Initialize3DFromImages(const Image* images, size_t depth,
     return S_OK;
 }
 
+_Use_decl_annotations_
+HRESULT ScratchImage::Attach(const TexMetadata& mdata, void* pixels, size_t size, CP_FLAGS flags) noexcept
+{
+    if (!pixels || !size || !mdata.mipLevels)
+        return E_INVALIDARG;
+
+    // 128 bpp formats are read through XMVECTOR pointers
+    const uintptr_t alignMask = (BitsPerPixel(mdata.format) >= 128) ? 0xF : 0x3;
+    if (reinterpret_cast<uintptr_t>(pixels) & alignMask)
+        return E_INVALIDARG;
+
+    size_t pixelSize, nimages;
+    if (!_DetermineImageArray(mdata, flags, nimages, pixelSize))
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    if (pixelSize > size)
+        return HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER);
+
+    Release();
+
+    m_memory = static_cast<uint8_t*>(pixels);
+    m_capacity = size;
+    m_external = true;
+
+    // Initialize validates the metadata and lays out the images in the attached memory
+    HRESULT hr = Initialize(mdata, flags);
+    if (FAILED(hr))
+    {
+        Release();
+        return hr;
+    }
+
+    assert(m_memory == pixels);
+    return S_OK;
+}
+
+_Use_decl_annotations_
+HRESULT ScratchImage::AttachMappedView(const TexMetadata& mdata, void* view, size_t offset, size_t size) noexcept
+{
+    if (!view || offset >= size)
+        return E_INVALIDARG;
+
+    HRESULT hr = Attach(mdata, static_cast<uint8_t*>(view) + offset, size - offset);
+    if (FAILED(hr))
+        return hr;
+
+    m_mappedView = view;
+
+    // Reserve never reuses memory with no capacity, so later output goes to a fresh allocation
+    // rather than forcing a private copy of every mapped page
+    m_capacity = 0;
+
+    return S_OK;
+}
+
 void ScratchImage::Release() noexcept
+{
+    Recycle();
+    FreeMemory();
+}
+
+void ScratchImage::Recycle() noexcept
 {
     m_nimages = 0;
     m_size = 0;
@@ -688,13 +753,55 @@ void ScratchImage::Release() noexcept
         m_image = nullptr;
     }
 
-    if (m_memory)
+    memset(&m_metadata, 0, sizeof(m_metadata));
+}
+
+_Use_decl_annotations_
+void ScratchImage::Swap(ScratchImage& other) noexcept
+{
+    std::swap(m_nimages, other.m_nimages);
+    std::swap(m_size, other.m_size);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_metadata, other.m_metadata);
+    std::swap(m_image, other.m_image);
+    std::swap(m_memory, other.m_memory);
+    std::swap(m_allocator, other.m_allocator);
+    std::swap(m_external, other.m_external);
+    std::swap(m_mappedView, other.m_mappedView);
+}
+
+_Use_decl_annotations_
+bool ScratchImage::Reserve(size_t pixelSize) noexcept
+{
+    if (m_memory && pixelSize <= m_capacity)
+        return true;
+
+    // Attached memory is never freed, only replaced by an owned allocation
+    FreeMemory();
+
+    m_memory = static_cast<uint8_t*>(_AlignedAlloc(pixelSize, 16, m_allocator));
+    if (!m_memory)
+        return false;
+
+    m_capacity = pixelSize;
+    return true;
+}
+
+void ScratchImage::FreeMemory() noexcept
+{
+    if (m_mappedView)
+    {
+        (void)UnmapViewOfFile(m_mappedView);
+        m_mappedView = nullptr;
+    }
+    else if (m_memory && !m_external)
     {
-        _aligned_free(m_memory);
-        m_memory = nullptr;
+        _AlignedFree(m_memory);
     }
 
-    memset(&m_metadata, 0, sizeof(m_metadata));
+    m_memory = nullptr;
+    m_capacity = 0;
+    m_external = false;
 }
 
 _Use_decl_annotations_
@@ -786,7 +893,7 @@ bool ScratchImage::IsAlphaAllOpaque() const noexcept
     }
     else
     {
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*m_metadata.width), 16)));
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*m_metadata.width), 16)));
         if (!scanline)
             return false;
 
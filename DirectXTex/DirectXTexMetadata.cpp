@@ -0,0 +1,544 @@
+//-------------------------------------------------------------------------------------
+// DirectXTexMetadata.cpp
+//
+// DirectX Texture Library - Bulk metadata scanning with an optional on-disk catalog
+//
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+//
+// http://go.microsoft.com/fwlink/?LinkId=248926
+//-------------------------------------------------------------------------------------
+
+#include "DirectXTexP.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace DirectX;
+
+namespace
+{
+    //-------------------------------------------------------------------------------------
+    // Catalog file layout: header, records sorted by path hash, then the path string table
+    //-------------------------------------------------------------------------------------
+    constexpr uint32_t CATALOG_MAGIC = 0x54435854; // "TXCT"
+    constexpr uint32_t CATALOG_VERSION = 1;
+
+    constexpr size_t CATALOG_MAX_SIZE = 0x40000000;
+        // Larger files are ignored rather than read
+
+#pragma pack(push,1)
+    struct CATALOG_HEADER
+    {
+        uint32_t    magic;
+        uint32_t    version;
+        uint32_t    ddsFlags;       // Loader flags the metadata was produced with
+        uint32_t    tgaFlags;
+        uint32_t    recordCount;
+        uint32_t    stringLength;   // In wchar_t units
+    };
+
+    struct CATALOG_RECORD
+    {
+        uint64_t    pathHash;
+        uint64_t    fileSize;
+        uint64_t    lastWriteTime;
+        uint32_t    pathOffset;     // In wchar_t units into the string table
+        uint32_t    pathLength;
+        uint32_t    width;
+        uint32_t    height;
+        uint32_t    depth;
+        uint32_t    arraySize;
+        uint32_t    mipLevels;
+        uint32_t    miscFlags;
+        uint32_t    miscFlags2;
+        uint32_t    format;
+        uint32_t    dimension;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(CATALOG_HEADER) == 24, "Catalog header size mismatch");
+    static_assert(sizeof(CATALOG_RECORD) == 68, "Catalog record size mismatch");
+
+    struct Catalog
+    {
+        std::unique_ptr<CATALOG_RECORD[]>   records;
+        std::unique_ptr<wchar_t[]>          strings;
+        size_t                              recordCount;
+        size_t                              stringLength;
+
+        Catalog() noexcept : recordCount(0), stringLength(0) {}
+    };
+
+    // Per-file state gathered during the scan
+    struct ScanEntry
+    {
+        uint64_t    fileSize;
+        uint64_t    lastWriteTime;
+        size_t      match;          // Catalog record with the same path, or SIZE_MAX
+        bool        cached;
+    };
+
+    enum SCAN_CODEC
+    {
+        SCAN_CODEC_UNKNOWN = 0,
+        SCAN_CODEC_DDS,
+        SCAN_CODEC_TGA,
+        SCAN_CODEC_HDR,
+    };
+
+    //-------------------------------------------------------------------------------------
+    // FNV-1a over the path characters
+    //-------------------------------------------------------------------------------------
+    uint64_t HashPath(_In_reads_(length) const wchar_t* path, size_t length) noexcept
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for (size_t j = 0; j < length; ++j)
+        {
+            hash ^= static_cast<uint16_t>(path[j]);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    SCAN_CODEC GetCodec(_In_z_ const wchar_t* path) noexcept
+    {
+        const wchar_t* ext = nullptr;
+        for (const wchar_t* ptr = path; *ptr; ++ptr)
+        {
+            if (*ptr == L'.')
+                ext = ptr;
+            else if (*ptr == L'\\' || *ptr == L'/')
+                ext = nullptr;
+        }
+
+        if (!ext)
+            return SCAN_CODEC_UNKNOWN;
+
+        if (_wcsicmp(ext, L".dds") == 0)
+            return SCAN_CODEC_DDS;
+        else if (_wcsicmp(ext, L".tga") == 0)
+            return SCAN_CODEC_TGA;
+        else if (_wcsicmp(ext, L".hdr") == 0)
+            return SCAN_CODEC_HDR;
+
+        return SCAN_CODEC_UNKNOWN;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Catalog records <-> TexMetadata
+    //-------------------------------------------------------------------------------------
+    void RecordToMetadata(_In_ const CATALOG_RECORD& record, _Out_ TexMetadata& metadata) noexcept
+    {
+        metadata.width = record.width;
+        metadata.height = record.height;
+        metadata.depth = record.depth;
+        metadata.arraySize = record.arraySize;
+        metadata.mipLevels = record.mipLevels;
+        metadata.miscFlags = record.miscFlags;
+        metadata.miscFlags2 = record.miscFlags2;
+        metadata.format = static_cast<DXGI_FORMAT>(record.format);
+        metadata.dimension = static_cast<TEX_DIMENSION>(record.dimension);
+    }
+
+    bool MetadataToRecord(_In_ const TexMetadata& metadata, _Out_ CATALOG_RECORD& record) noexcept
+    {
+        memset(&record, 0, sizeof(record));
+
+        if (metadata.width > UINT32_MAX
+            || metadata.height > UINT32_MAX
+            || metadata.depth > UINT32_MAX
+            || metadata.arraySize > UINT32_MAX
+            || metadata.mipLevels > UINT32_MAX)
+            return false;
+
+        record.width = static_cast<uint32_t>(metadata.width);
+        record.height = static_cast<uint32_t>(metadata.height);
+        record.depth = static_cast<uint32_t>(metadata.depth);
+        record.arraySize = static_cast<uint32_t>(metadata.arraySize);
+        record.mipLevels = static_cast<uint32_t>(metadata.mipLevels);
+        record.miscFlags = metadata.miscFlags;
+        record.miscFlags2 = metadata.miscFlags2;
+        record.format = static_cast<uint32_t>(metadata.format);
+        record.dimension = static_cast<uint32_t>(metadata.dimension);
+        return true;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Finds the record for a path (records are sorted by hash)
+    //-------------------------------------------------------------------------------------
+    size_t FindRecord(_In_ const Catalog& catalog, _In_z_ const wchar_t* path) noexcept
+    {
+        const size_t length = wcslen(path);
+        const uint64_t hash = HashPath(path, length);
+
+        size_t lo = 0;
+        size_t hi = catalog.recordCount;
+        while (lo < hi)
+        {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (catalog.records[mid].pathHash < hash)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+
+        for (; lo < catalog.recordCount && catalog.records[lo].pathHash == hash; ++lo)
+        {
+            const CATALOG_RECORD& record = catalog.records[lo];
+            if (record.pathLength == length
+                && memcmp(catalog.strings.get() + record.pathOffset, path, length * sizeof(wchar_t)) == 0)
+            {
+                return lo;
+            }
+        }
+
+        return SIZE_MAX;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Reads a catalog; a missing, stale or malformed catalog simply loads as empty
+    //-------------------------------------------------------------------------------------
+    void LoadCatalog(_In_z_ const wchar_t* szCatalog, DDS_FLAGS ddsFlags, TGA_FLAGS tgaFlags, _Out_ Catalog& catalog) noexcept
+    {
+        catalog.records.reset();
+        catalog.strings.reset();
+        catalog.recordCount = catalog.stringLength = 0;
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+        ScopedHandle hFile(safe_handle(CreateFile2(szCatalog, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, nullptr)));
+#else
+        ScopedHandle hFile(safe_handle(CreateFileW(szCatalog, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_FLAG_SEQUENTIAL_SCAN, nullptr)));
+#endif
+        if (!hFile)
+            return;
+
+        FILE_STANDARD_INFO fileInfo;
+        if (!GetFileInformationByHandleEx(hFile.get(), FileStandardInfo, &fileInfo, sizeof(fileInfo)))
+            return;
+
+        if (fileInfo.EndOfFile.HighPart > 0 || fileInfo.EndOfFile.LowPart > CATALOG_MAX_SIZE)
+            return;
+
+        CATALOG_HEADER header = {};
+        DWORD bytesRead = 0;
+        if (!ReadFile(hFile.get(), &header, sizeof(header), &bytesRead, nullptr) || bytesRead != sizeof(header))
+            return;
+
+        if (header.magic != CATALOG_MAGIC
+            || header.version != CATALOG_VERSION
+            || header.ddsFlags != static_cast<uint32_t>(ddsFlags)
+            || header.tgaFlags != static_cast<uint32_t>(tgaFlags))
+            return;
+
+        const uint64_t recordBytes = uint64_t(header.recordCount) * sizeof(CATALOG_RECORD);
+        const uint64_t stringBytes = uint64_t(header.stringLength) * sizeof(wchar_t);
+        if (sizeof(header) + recordBytes + stringBytes != fileInfo.EndOfFile.LowPart)
+            return;
+
+        std::unique_ptr<CATALOG_RECORD[]> records(new (std::nothrow) CATALOG_RECORD[header.recordCount]);
+        std::unique_ptr<wchar_t[]> strings(new (std::nothrow) wchar_t[header.stringLength]);
+        if (!records || !strings)
+            return;
+
+        if (recordBytes > 0)
+        {
+            if (!ReadFile(hFile.get(), records.get(), static_cast<DWORD>(recordBytes), &bytesRead, nullptr)
+                || bytesRead != recordBytes)
+                return;
+        }
+
+        if (stringBytes > 0)
+        {
+            if (!ReadFile(hFile.get(), strings.get(), static_cast<DWORD>(stringBytes), &bytesRead, nullptr)
+                || bytesRead != stringBytes)
+                return;
+        }
+
+        for (size_t j = 0; j < header.recordCount; ++j)
+        {
+            const CATALOG_RECORD& record = records[j];
+            if (uint64_t(record.pathOffset) + record.pathLength > header.stringLength
+                || (j > 0 && records[j - 1].pathHash > record.pathHash))
+                return;
+        }
+
+        catalog.records = std::move(records);
+        catalog.strings = std::move(strings);
+        catalog.recordCount = header.recordCount;
+        catalog.stringLength = header.stringLength;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Writes the scanned files plus any old records for paths not in this scan
+    //-------------------------------------------------------------------------------------
+    HRESULT SaveCatalog(
+        _In_z_ const wchar_t* szCatalog,
+        DDS_FLAGS ddsFlags,
+        TGA_FLAGS tgaFlags,
+        _In_ const Catalog& old,
+        _In_reads_(nfiles) const wchar_t* const* files,
+        size_t nfiles,
+        _In_reads_(nfiles) const ScanEntry* entries,
+        _In_reads_(nfiles) const TexMetadata* metadata,
+        _In_reads_(nfiles) const HRESULT* results) noexcept
+    {
+        std::unique_ptr<bool[]> keep(new (std::nothrow) bool[old.recordCount + 1]);
+        std::unique_ptr<bool[]> write(new (std::nothrow) bool[nfiles]);
+        if (!keep || !write)
+            return E_OUTOFMEMORY;
+
+        for (size_t j = 0; j < old.recordCount; ++j)
+            keep[j] = true;
+
+        // Each path is written once, so a repeated path in the list doesn't duplicate records
+        uint64_t recordCount = 0;
+        uint64_t stringLength = 0;
+        for (size_t j = 0; j < nfiles; ++j)
+        {
+            write[j] = false;
+
+            if (entries[j].match != SIZE_MAX)
+            {
+                if (!keep[entries[j].match])
+                    continue;
+
+                keep[entries[j].match] = false;
+            }
+
+            CATALOG_RECORD record;
+            if (SUCCEEDED(results[j]) && MetadataToRecord(metadata[j], record))
+            {
+                write[j] = true;
+                ++recordCount;
+                stringLength += wcslen(files[j]);
+            }
+        }
+
+        for (size_t j = 0; j < old.recordCount; ++j)
+        {
+            if (keep[j])
+            {
+                ++recordCount;
+                stringLength += old.records[j].pathLength;
+            }
+        }
+
+        if (recordCount > UINT32_MAX
+            || stringLength > UINT32_MAX
+            || (sizeof(CATALOG_HEADER) + recordCount * sizeof(CATALOG_RECORD) + stringLength * sizeof(wchar_t)) > CATALOG_MAX_SIZE)
+            return HRESULT_FROM_WIN32(ERROR_FILE_TOO_LARGE);
+
+        std::unique_ptr<CATALOG_RECORD[]> records(new (std::nothrow) CATALOG_RECORD[static_cast<size_t>(recordCount) + 1]);
+        std::unique_ptr<wchar_t[]> strings(new (std::nothrow) wchar_t[static_cast<size_t>(stringLength) + 1]);
+        if (!records || !strings)
+            return E_OUTOFMEMORY;
+
+        size_t count = 0;
+        size_t offset = 0;
+        for (size_t j = 0; j < nfiles; ++j)
+        {
+            if (!write[j])
+                continue;
+
+            const size_t length = wcslen(files[j]);
+
+            CATALOG_RECORD& record = records[count++];
+            (void)MetadataToRecord(metadata[j], record);
+            record.pathHash = HashPath(files[j], length);
+            record.fileSize = entries[j].fileSize;
+            record.lastWriteTime = entries[j].lastWriteTime;
+            record.pathOffset = static_cast<uint32_t>(offset);
+            record.pathLength = static_cast<uint32_t>(length);
+
+            memcpy(strings.get() + offset, files[j], length * sizeof(wchar_t));
+            offset += length;
+        }
+
+        for (size_t j = 0; j < old.recordCount; ++j)
+        {
+            if (!keep[j])
+                continue;
+
+            CATALOG_RECORD& record = records[count++];
+            record = old.records[j];
+            record.pathOffset = static_cast<uint32_t>(offset);
+
+            memcpy(strings.get() + offset, old.strings.get() + old.records[j].pathOffset, record.pathLength * sizeof(wchar_t));
+            offset += record.pathLength;
+        }
+
+        std::sort(records.get(), records.get() + count,
+            [](const CATALOG_RECORD& a, const CATALOG_RECORD& b) noexcept { return a.pathHash < b.pathHash; });
+
+        CATALOG_HEADER header = {};
+        header.magic = CATALOG_MAGIC;
+        header.version = CATALOG_VERSION;
+        header.ddsFlags = static_cast<uint32_t>(ddsFlags);
+        header.tgaFlags = static_cast<uint32_t>(tgaFlags);
+        header.recordCount = static_cast<uint32_t>(count);
+        header.stringLength = static_cast<uint32_t>(offset);
+
+#if (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+        ScopedHandle hFile(safe_handle(CreateFile2(szCatalog, GENERIC_WRITE | DELETE, 0, CREATE_ALWAYS, nullptr)));
+#else
+        ScopedHandle hFile(safe_handle(CreateFileW(szCatalog, GENERIC_WRITE | DELETE, 0, nullptr, CREATE_ALWAYS, 0, nullptr)));
+#endif
+        if (!hFile)
+        {
+            return HRESULT_FROM_WIN32(GetLastError());
+        }
+
+        auto_delete_file delonfail(hFile.get());
+
+        const void* chunks[3] = { &header, records.get(), strings.get() };
+        const size_t sizes[3] = { sizeof(header), count * sizeof(CATALOG_RECORD), offset * sizeof(wchar_t) };
+        for (size_t j = 0; j < 3; ++j)
+        {
+            if (!sizes[j])
+                continue;
+
+            DWORD bytesWritten;
+            if (!WriteFile(hFile.get(), chunks[j], static_cast<DWORD>(sizes[j]), &bytesWritten, nullptr))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            if (bytesWritten != sizes[j])
+            {
+                return E_FAIL;
+            }
+        }
+
+        delonfail.clear();
+
+        return S_OK;
+    }
+
+    //-------------------------------------------------------------------------------------
+    // Stats one file (when cataloging), then reads its header unless the catalog already has it
+    //-------------------------------------------------------------------------------------
+    HRESULT ScanFile(
+        _In_z_ const wchar_t* szFile,
+        DDS_FLAGS ddsFlags,
+        TGA_FLAGS tgaFlags,
+        _In_opt_ const Catalog* catalog,
+        _Out_ ScanEntry& entry,
+        _Out_ TexMetadata& metadata) noexcept
+    {
+        memset(&entry, 0, sizeof(entry));
+        entry.match = SIZE_MAX;
+        memset(&metadata, 0, sizeof(metadata));
+
+        if (!szFile)
+            return E_INVALIDARG;
+
+        const SCAN_CODEC codec = GetCodec(szFile);
+        if (codec == SCAN_CODEC_UNKNOWN)
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+        if (catalog)
+        {
+            // Attributes are taken before the header is read, so a file modified mid-scan is seen as stale next time
+            WIN32_FILE_ATTRIBUTE_DATA data = {};
+            if (!GetFileAttributesExW(szFile, GetFileExInfoStandard, &data))
+            {
+                return HRESULT_FROM_WIN32(GetLastError());
+            }
+
+            entry.fileSize = (uint64_t(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+            entry.lastWriteTime = (uint64_t(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+
+            entry.match = FindRecord(*catalog, szFile);
+            if (entry.match != SIZE_MAX)
+            {
+                const CATALOG_RECORD& record = catalog->records[entry.match];
+                if (record.fileSize == entry.fileSize && record.lastWriteTime == entry.lastWriteTime)
+                {
+                    RecordToMetadata(record, metadata);
+                    entry.cached = true;
+                    return S_OK;
+                }
+            }
+        }
+
+        switch (codec)
+        {
+        case SCAN_CODEC_DDS:
+            return GetMetadataFromDDSFile(szFile, ddsFlags, metadata);
+
+        case SCAN_CODEC_TGA:
+            return GetMetadataFromTGAFile(szFile, tgaFlags, metadata);
+
+        case SCAN_CODEC_HDR:
+            return GetMetadataFromHDRFile(szFile, metadata);
+
+        default:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+    }
+}
+
+
+//=====================================================================================
+// Entry-points
+//=====================================================================================
+
+//-------------------------------------------------------------------------------------
+// Reads the metadata of many .dds, .tga and .hdr files
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::GetMetadataFromFiles(
+    const wchar_t* const* files,
+    size_t nfiles,
+    DDS_FLAGS ddsFlags,
+    TGA_FLAGS tgaFlags,
+    TexMetadata* metadata,
+    HRESULT* results,
+    const wchar_t* szCatalog) noexcept
+{
+    if (!files || !nfiles || !metadata || !results)
+        return E_INVALIDARG;
+
+    if (nfiles > INT32_MAX)
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    std::unique_ptr<ScanEntry[]> entries(new (std::nothrow) ScanEntry[nfiles]);
+    if (!entries)
+        return E_OUTOFMEMORY;
+
+    Catalog catalog;
+    if (szCatalog)
+    {
+        LoadCatalog(szCatalog, ddsFlags, tgaFlags, catalog);
+    }
+
+    // Headers are tiny, so the scan is bound by file open latency and benefits from many requests in flight
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 16)
+#endif
+    for (int j = 0; j < static_cast<int>(nfiles); ++j)
+    {
+        results[j] = ScanFile(files[j], ddsFlags, tgaFlags, (szCatalog) ? &catalog : nullptr, entries[j], metadata[j]);
+    }
+
+    if (!szCatalog)
+        return S_OK;
+
+    // Only rewrite the catalog when this scan learned something new
+    bool changed = false;
+    for (size_t j = 0; j < nfiles && !changed; ++j)
+    {
+        if (!entries[j].cached && (SUCCEEDED(results[j]) || entries[j].match != SIZE_MAX))
+            changed = true;
+    }
+
+    if (!changed)
+        return S_OK;
+
+    // The scan itself succeeded, so a catalog that cannot be written (read-only, locked) is only a warning
+    HRESULT hr = SaveCatalog(szCatalog, ddsFlags, tgaFlags, catalog, files, nfiles, entries.get(), metadata, results);
+    return SUCCEEDED(hr) ? S_OK : S_FALSE;
+}
@@ -13,6 +13,11 @@
 
 #include "filters.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#pragma warning(disable : 4616 6993)
+#endif
+
 using namespace DirectX;
 using Microsoft::WRL::ComPtr;
 
@@ -142,7 +147,7 @@ namespace
         assert(srcImage.width == destImage.width);
         assert(srcImage.height == destImage.height);
 
-        ScopedAlignedArrayXMVECTOR scanline(reinterpret_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*srcImage.width), 16)));
+        ScopedAlignedArrayXMVECTOR scanline(reinterpret_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*srcImage.width), 16)));
         if (!scanline)
         {
             return E_OUTOFMEMORY;
@@ -185,6 +190,18 @@ namespace
     }
 
 
+    constexpr size_t ALPHA_COVERAGE_SAMPLES = 8;
+        // Supersampling grid (N x N) used for each 2x2 pixel quad
+
+    constexpr float ALPHA_COVERAGE_MAX_SCALE = 4.f;
+        // Upper bound of the alpha scale search range
+
+    constexpr size_t ALPHA_COVERAGE_BINS = 16384;
+        // Histogram resolution over [0, ALPHA_COVERAGE_MAX_SCALE)
+
+    constexpr size_t ALPHA_COVERAGE_BAND_ROWS = 64;
+        // Rows of quads histogrammed per work item
+
     void GenerateAlphaCoverageConvolutionVectors(
         _In_ size_t N,
         _Out_writes_(N*N) XMVECTOR* vectors) noexcept
@@ -214,13 +231,13 @@ namespace
     {
         coverage = 0.0f;
 
-        ScopedAlignedArrayXMVECTOR row0(reinterpret_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*srcImage.width), 16)));
+        ScopedAlignedArrayXMVECTOR row0(reinterpret_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*srcImage.width), 16)));
         if (!row0)
         {
             return E_OUTOFMEMORY;
         }
 
-        ScopedAlignedArrayXMVECTOR row1(reinterpret_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*srcImage.width), 16)));
+        ScopedAlignedArrayXMVECTOR row1(reinterpret_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*srcImage.width), 16)));
         if (!row1)
         {
             return E_OUTOFMEMORY;
@@ -234,7 +251,7 @@ namespace
             return E_POINTER;
         }
 
-        const size_t N = 8;
+        constexpr size_t N = ALPHA_COVERAGE_SAMPLES;
         XMVECTOR convolution[N * N];
         GenerateAlphaCoverageConvolutionVectors(N, convolution);
 
@@ -257,10 +274,10 @@ namespace
             for (size_t x = 0; x < srcImage.width - 1; ++x)
             {
                 // [0]=(x+0, y+0), [1]=(x+0, y+1), [2]=(x+1, y+0), [3]=(x+1, y+1)
-                XMVECTOR v1 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(*pRow0), scale));
-                XMVECTOR v2 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(*pRow1), scale));
-                XMVECTOR v3 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(*(pRow0++)), scale));
-                XMVECTOR v4 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(*(pRow1++)), scale));
+                XMVECTOR v1 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(pRow0[x]), scale));
+                XMVECTOR v2 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(pRow1[x]), scale));
+                XMVECTOR v3 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(pRow0[x + 1]), scale));
+                XMVECTOR v4 = XMVectorSaturate(XMVectorMultiply(XMVectorSplatW(pRow1[x + 1]), scale));
 
                 v1 = XMVectorMergeXY(v1, v2); // [v1.x v2.x --- ---]
                 v3 = XMVectorMergeXY(v3, v4); // [v3.x v4.x --- ---]
@@ -272,8 +289,8 @@ namespace
                     const size_t ry = sy * N;
                     for (size_t sx = 0; sx < N; ++sx)
                     {
-                        v = VectorSum(XMVectorMultiply(v, convolution[ry + sx]));
-                        if (XMVectorGetX(v) > alphaReference)
+                        const XMVECTOR sv = VectorSum(XMVectorMultiply(v, convolution[ry + sx]));
+                        if (XMVectorGetX(sv) > alphaReference)
                         {
                             ++coverageCount;
                         }
@@ -294,52 +311,173 @@ namespace
     }
 
 
-    HRESULT EstimateAlphaScaleForCoverage(
-            const Image& srcImage,
-            float alphaReference,
-            float targetCoverage,
-            float& alphaScale) noexcept
+    //--- Accumulates a histogram of the smallest alpha scale at which each supersample passes the reference ---
+    // A sample is sum(w[i] * saturate(scale * alpha[i])), which is piecewise linear and non-decreasing in scale,
+    // so its crossing point can be solved for directly; coverage at a given scale is then the count of samples
+    // whose crossing is below it.
+    HRESULT AccumulateAlphaCoverageHistogram(
+        const Image& srcImage,
+        float alphaReference,
+        size_t y0,
+        size_t y1,
+        _Out_writes_(ALPHA_COVERAGE_BINS) uint32_t* histogram) noexcept
     {
-        float minAlphaScale = 0.0f;
-        float maxAlphaScale = 4.0f;
-        float bestError = FLT_MAX;
+        memset(histogram, 0, sizeof(uint32_t) * ALPHA_COVERAGE_BINS);
 
-        // Determine desired scale using a binary search. Hardcoded to 10 steps max.
-        alphaScale = 1.0f;
-        const size_t N = 10;
-        for (size_t i = 0; i < N; ++i)
+        ScopedAlignedArrayXMVECTOR scanline(reinterpret_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*srcImage.width * 2), 16)));
+        if (!scanline)
         {
-            float currentCoverage = 0.0f;
-            HRESULT hr = CalculateAlphaCoverage(srcImage, alphaReference, alphaScale, currentCoverage);
-            if (FAILED(hr))
-            {
-                return hr;
-            }
+            return E_OUTOFMEMORY;
+        }
 
-            const float error = fabsf(currentCoverage - targetCoverage);
-            if (error < bestError)
-            {
-                bestError = error;
-            }
+        if (!srcImage.pixels)
+        {
+            return E_POINTER;
+        }
+
+        constexpr size_t N = ALPHA_COVERAGE_SAMPLES;
+        XMVECTOR convolution[N * N];
+        GenerateAlphaCoverageConvolutionVectors(N, convolution);
+
+        const float binScale = float(ALPHA_COVERAGE_BINS) / ALPHA_COVERAGE_MAX_SCALE;
 
-            if (currentCoverage < targetCoverage)
+        XMVECTOR* row0 = scanline.get();
+        XMVECTOR* row1 = row0 + srcImage.width;
+
+        const uint8_t* pSrc = srcImage.pixels + srcImage.rowPitch * y0;
+        if (!_LoadScanlineLinear(row0, srcImage.width, pSrc, srcImage.rowPitch, srcImage.format, TEX_FILTER_DEFAULT))
+        {
+            return E_FAIL;
+        }
+
+        for (size_t y = y0; y < y1; ++y)
+        {
+            pSrc += srcImage.rowPitch;
+            if (!_LoadScanlineLinear(row1, srcImage.width, pSrc, srcImage.rowPitch, srcImage.format, TEX_FILTER_DEFAULT))
             {
-                minAlphaScale = alphaScale;
+                return E_FAIL;
             }
-            else if (currentCoverage > targetCoverage)
+
+            for (size_t x = 0; x < srcImage.width - 1; ++x)
             {
-                maxAlphaScale = alphaScale;
+                // [0]=(x+0, y+0), [1]=(x+0, y+1), [2]=(x+1, y+0), [3]=(x+1, y+1)
+                float alpha[4] = { XMVectorGetW(row0[x]), XMVectorGetW(row1[x]), XMVectorGetW(row0[x + 1]), XMVectorGetW(row1[x + 1]) };
+
+                // Corners saturate in order of decreasing alpha; corners at or below zero never contribute
+                size_t order[4] = { 0, 1, 2, 3 };
+                std::sort(order, order + 4, [&alpha](size_t a, size_t b) noexcept { return alpha[a] > alpha[b]; });
+
+                size_t active = 0;
+                while (active < 4 && alpha[order[active]] > 0.f)
+                    ++active;
+
+                for (size_t s = 0; s < N * N; ++s)
+                {
+                    XMFLOAT4A w;
+                    XMStoreFloat4A(&w, convolution[s]);
+                    const float weight[4] = { w.x, w.y, w.z, w.w };
+
+                    // On each segment the sample is slope * scale + offset
+                    float slope = 0.f;
+                    for (size_t j = 0; j < active; ++j)
+                    {
+                        slope += weight[order[j]] * alpha[order[j]];
+                    }
+
+                    float offset = 0.f;
+                    float knee = 0.f;
+                    float crossing = FLT_MAX;
+                    for (size_t j = 0; j <= active; ++j)
+                    {
+                        const float next = (j < active) ? (1.f / alpha[order[j]]) : FLT_MAX;
+                        if (slope > 0.f)
+                        {
+                            const float k = (alphaReference - offset) / slope;
+                            if (k < next)
+                            {
+                                crossing = std::max(k, knee);
+                                break;
+                            }
+                        }
+                        else if (offset > alphaReference)
+                        {
+                            crossing = knee;
+                            break;
+                        }
+
+                        if (j < active)
+                        {
+                            slope -= weight[order[j]] * alpha[order[j]];
+                            offset += weight[order[j]];
+                            knee = next;
+                        }
+                    }
+
+                    if (crossing < ALPHA_COVERAGE_MAX_SCALE)
+                    {
+                        const auto bin = std::min<size_t>(static_cast<size_t>(std::max(crossing, 0.f) * binScale), ALPHA_COVERAGE_BINS - 1);
+                        ++histogram[bin];
+                    }
+                }
             }
-            else
-            {
+
+            std::swap(row0, row1);
+        }
+
+        return S_OK;
+    }
+
+
+    //--- Picks the scale whose coverage from the histogram is closest to the target ---
+    float SolveAlphaScaleForCoverage(
+        _In_reads_(ALPHA_COVERAGE_BINS) const uint64_t* histogram,
+        uint64_t total,
+        float targetCoverage) noexcept
+    {
+        if (!total)
+        {
+            // No samples, so nothing can be matched
+            return (targetCoverage > 0.f) ? ALPHA_COVERAGE_MAX_SCALE : 1.f;
+        }
+
+        const double target = double(targetCoverage) * double(total);
+
+        // Edge e of the histogram is the scale e * MAX_SCALE / BINS, and covers every sample in the bins below it
+        uint64_t below = 0;
+        size_t edge = 0;
+        for (; edge < ALPHA_COVERAGE_BINS; ++edge)
+        {
+            if (double(below) >= target)
                 break;
+            below += histogram[edge];
+        }
+
+        if (edge > 0 && double(below) >= target)
+        {
+            const uint64_t prev = below - histogram[edge - 1];
+            if ((target - double(prev)) < (double(below) - target))
+            {
+                --edge;
+                below = prev;
             }
+        }
 
-            alphaScale = (minAlphaScale + maxAlphaScale) * 0.5f;
+        // Leave alpha unscaled when that matches just as well
+        constexpr size_t unity = ALPHA_COVERAGE_BINS / 4;
+        static_assert(ALPHA_COVERAGE_MAX_SCALE == 4.f, "unity edge assumes a [0,4) search range");
+
+        uint64_t belowUnity = 0;
+        for (size_t j = 0; j < unity; ++j)
+        {
+            belowUnity += histogram[j];
         }
 
-        return S_OK;
+        if (fabs(double(belowUnity) - target) <= fabs(double(below) - target))
+            return 1.f;
+
+        return float(edge) * (ALPHA_COVERAGE_MAX_SCALE / float(ALPHA_COVERAGE_BINS));
     }
+
 }
 
 
@@ -674,7 +812,10 @@ namespace
             break;
 
         case TEX_FILTER_TRIANGLE:
-            // WIC does not implement this filter
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_MITCHELL:
+        case TEX_FILTER_KAISER:
+            // WIC does not implement these filters
             return false;
         }
 
@@ -827,6 +968,33 @@ namespace
     //-------------------------------------------------------------------------------------
     // Generate (1D/2D) mip-map helpers (custom filtering)
     //-------------------------------------------------------------------------------------
+    constexpr size_t MIP_PARALLEL_MIN_PIXELS = 16384;
+        // Smallest mip level which is split into bands of rows across threads
+
+    // Number of threads available for row bands (1 when already running inside a parallel region)
+    inline size_t MipThreadCount() noexcept
+    {
+#ifdef _OPENMP
+        if (!omp_in_parallel())
+            return static_cast<size_t>(std::max(omp_get_max_threads(), 1));
+#endif
+        return 1;
+    }
+
+    inline size_t MipThreadIndex() noexcept
+    {
+#ifdef _OPENMP
+        return static_cast<size_t>(omp_get_thread_num());
+#else
+        return 0;
+#endif
+    }
+
+    inline bool UseRowBands(size_t threads, size_t nwidth, size_t nheight) noexcept
+    {
+        return (threads > 1) && (nheight > 1) && ((nwidth * nheight) >= MIP_PARALLEL_MIN_PIXELS);
+    }
+
     HRESULT Setup2DMips(
         _In_reads_(nimages) const Image* baseImages,
         _In_ size_t nimages,
@@ -895,22 +1063,17 @@ namespace
         size_t width = mipChain.GetMetadata().width;
         size_t height = mipChain.GetMetadata().height;
 
-        // Allocate temporary space (2 scanlines)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 2), 16)));
+        const size_t threads = MipThreadCount();
+        const size_t stride = width * 2;
+
+        // Allocate temporary space (2 scanlines per thread)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
 
-        XMVECTOR* target = scanline.get();
-
-        XMVECTOR* row = target + width;
-
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
-#ifdef _DEBUG
-            memset(row, 0xCD, sizeof(XMVECTOR)*width);
-#endif
-
             // 2D point filter
             const Image* src = mipChain.GetImage(level - 1, item, 0);
             const Image* dest = mipChain.GetImage(level, item, 0);
@@ -929,32 +1092,55 @@ namespace
             size_t xinc = (width << 16) / nwidth;
             size_t yinc = (height << 16) / nheight;
 
-            size_t lasty = size_t(-1);
+            bool fail = false;
 
-            size_t sy = 0;
-            for (size_t y = 0; y < nheight; ++y)
+#ifdef _OPENMP
+#pragma omp parallel num_threads(static_cast<int>(threads)) if (UseRowBands(threads, nwidth, nheight))
+#endif
             {
-                if ((lasty ^ sy) >> 16)
-                {
-                    if (!_LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src->format))
-                        return E_FAIL;
-                    lasty = sy;
-                }
+                XMVECTOR* target = scanline.get() + stride * MipThreadIndex();
+                XMVECTOR* row = target + width;
+
+#ifdef _DEBUG
+                memset(row, 0xCD, sizeof(XMVECTOR)*width);
+#endif
+
+                size_t lasty = size_t(-1);
 
-                size_t sx = 0;
-                for (size_t x = 0; x < nwidth; ++x)
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                for (int y = 0; y < static_cast<int>(nheight); ++y)
                 {
-                    target[x] = row[sx >> 16];
-                    sx += xinc;
-                }
+                    if (fail)
+                        continue;
 
-                if (!_StoreScanline(pDest, dest->rowPitch, dest->format, target, nwidth))
-                    return E_FAIL;
-                pDest += dest->rowPitch;
+                    size_t sy = yinc * size_t(y);
+                    if ((lasty ^ sy) >> 16)
+                    {
+                        if (!_LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src->format))
+                        {
+                            fail = true;
+                            continue;
+                        }
+                        lasty = sy;
+                    }
+
+                    size_t sx = 0;
+                    for (size_t x = 0; x < nwidth; ++x)
+                    {
+                        target[x] = row[sx >> 16];
+                        sx += xinc;
+                    }
 
-                sy += yinc;
+                    if (!_StoreScanline(pDest + (dest->rowPitch * size_t(y)), dest->rowPitch, dest->format, target, nwidth))
+                        fail = true;
+                }
             }
 
+            if (fail)
+                return E_FAIL;
+
             if (height > 1)
                 height >>= 1;
 
@@ -966,211 +1152,462 @@ namespace
     }
 
 
-    //--- 2D Box Filter ---
-    HRESULT Generate2DMipsBoxFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    //--- 2D Box Filter (8-bit RGBA integer path) ---
+    //
+    // Power-of-two R8G8B8A8/B8G8R8A8 mips reduce each 2x2 quad with 16-bit integer sums rounded to nearest.
+    // sRGB color channels go through a 16-bit linear lookup table and back instead of float conversions.
+    struct SRGBTables
     {
-        if (!mipChain.GetImages())
-            return E_INVALIDARG;
+        uint16_t    toLinear[256];
+        uint8_t     fromLinear[65536];
 
-        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
+        SRGBTables() noexcept
+        {
+            for (size_t i = 0; i < 256; ++i)
+            {
+                const float s = float(i) / 255.f;
+                const float l = (s <= 0.04045f) ? (s / 12.92f) : powf((s + 0.055f) / 1.055f, 2.4f);
+                toLinear[i] = static_cast<uint16_t>(std::min(l * 65535.f + 0.5f, 65535.f));
+            }
 
-        assert(levels > 1);
+            for (size_t i = 0; i < 65536; ++i)
+            {
+                const float l = float(i) / 65535.f;
+                const float s = (l <= 0.0031308f) ? (l * 12.92f) : (1.055f * powf(l, 1.0f / 2.4f) - 0.055f);
+                fromLinear[i] = static_cast<uint8_t>(std::min(std::max(s, 0.f) * 255.f + 0.5f, 255.f));
+            }
+        }
+    };
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
+    const SRGBTables& GetSRGBTables() noexcept
+    {
+        static const SRGBTables s_tables;
+        return s_tables;
+    }
 
-        if (!ispow2(width) || !ispow2(height))
-            return E_FAIL;
+    // Returns true if the integer path produces the same conversion semantics as _Load/_StoreScanlineLinear
+    bool UseBoxFilterRGBA8(DXGI_FORMAT format, TEX_FILTER_FLAGS filter, _Out_ bool& srgb) noexcept
+    {
+        srgb = false;
 
-        // Allocate temporary space (3 scanlines)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 3), 16)));
-        if (!scanline)
-            return E_OUTOFMEMORY;
+        if (filter & TEX_FILTER_FLOAT_MIPS)
+            return false;
 
-        XMVECTOR* target = scanline.get();
+        bool formatSRGB = false;
+        switch (format)
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+            break;
 
-        XMVECTOR* urow0 = target + width;
-        XMVECTOR* urow1 = target + width * 2;
+        case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
+        case DXGI_FORMAT_B8G8R8A8_UNORM_SRGB:
+            formatSRGB = true;
+            break;
 
-        const XMVECTOR* urow2 = urow0 + 1;
-        const XMVECTOR* urow3 = urow1 + 1;
+        default:
+            return false;
+        }
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
-        {
-            if (height <= 1)
-            {
-                urow1 = urow0;
-            }
+        const bool srgbIn = formatSRGB || (filter & TEX_FILTER_SRGB_IN);
+        const bool srgbOut = formatSRGB || (filter & TEX_FILTER_SRGB_OUT);
+        if (srgbIn != srgbOut)
+            return false;
 
-            if (width <= 1)
-            {
-                urow2 = urow0;
-                urow3 = urow1;
-            }
+        srgb = srgbIn;
+        return true;
+    }
 
-            // 2D box filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+    void BoxFilterRowRGBA8(
+        _Out_writes_bytes_(nwidth * 4) uint8_t* pDest,
+        _In_reads_bytes_(width * 4) const uint8_t* row0,
+        _In_reads_bytes_(width * 4) const uint8_t* row1,
+        size_t width,
+        size_t nwidth,
+        bool srgb) noexcept
+    {
+        size_t x = 0;
 
-            if (!src || !dest)
-                return E_POINTER;
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+        if (!srgb && width > 1)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i round = _mm_set1_epi16(2);
 
-            const uint8_t* pSrc = src->pixels;
-            uint8_t* pDest = dest->pixels;
+            // Eight source pixels from each row produce four destination pixels
+            for (; (x + 4) <= nwidth; x += 4)
+            {
+                const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+                const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + 16));
+                const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+                const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + 16));
+
+                const __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+                const __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+                const __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+                const __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+                __m128i h0 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+                __m128i h1 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+                h0 = _mm_srli_epi16(_mm_add_epi16(h0, round), 2);
+                h1 = _mm_srli_epi16(_mm_add_epi16(h1, round), 2);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDest + x * 4), _mm_packus_epi16(h0, h1));
+            }
+        }
+#endif
 
-            size_t rowPitch = src->rowPitch;
+        const SRGBTables* tables = (srgb) ? &GetSRGBTables() : nullptr;
 
-            size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            size_t nheight = (height > 1) ? (height >> 1) : 1;
+        for (; x < nwidth; ++x)
+        {
+            const size_t p0 = (x << 1) * 4;
+            const size_t p1 = (width > 1) ? (p0 + 4) : p0;
 
-            for (size_t y = 0; y < nheight; ++y)
+            for (size_t c = 0; c < 4; ++c)
             {
-                if (!_LoadScanlineLinear(urow0, width, pSrc, rowPitch, src->format, filter))
-                    return E_FAIL;
-                pSrc += rowPitch;
-
-                if (urow0 != urow1)
+                if (tables && c < 3)
                 {
-                    if (!_LoadScanlineLinear(urow1, width, pSrc, rowPitch, src->format, filter))
-                        return E_FAIL;
-                    pSrc += rowPitch;
+                    const uint32_t sum = uint32_t(tables->toLinear[row0[p0 + c]]) + tables->toLinear[row0[p1 + c]]
+                        + tables->toLinear[row1[p0 + c]] + tables->toLinear[row1[p1 + c]];
+                    pDest[x * 4 + c] = tables->fromLinear[(sum + 2) >> 2];
                 }
-
-                for (size_t x = 0; x < nwidth; ++x)
+                else
                 {
-                    size_t x2 = x << 1;
-
-                    AVERAGE4(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2])
+                    const uint32_t sum = uint32_t(row0[p0 + c]) + row0[p1 + c] + row1[p0 + c] + row1[p1 + c];
+                    pDest[x * 4 + c] = static_cast<uint8_t>((sum + 2) >> 2);
                 }
-
-                if (!_StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                    return E_FAIL;
-                pDest += dest->rowPitch;
             }
-
-            if (height > 1)
-                height >>= 1;
-
-            if (width > 1)
-                width >>= 1;
         }
-
-        return S_OK;
     }
 
 
-    //--- 2D Linear Filter ---
-    HRESULT Generate2DMipsLinearFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
-    {
-        if (!mipChain.GetImages())
-            return E_INVALIDARG;
+    //--- 2D Box/Linear Filter pyramid ---
+    //
+    // Rather than producing each level in turn from the whole of the previous one, rows are generated in
+    // a single sweep down the base image: each band of rows written to a level is reduced into the next
+    // level right away, while it is still in cache. By default every level is reloaded from its stored
+    // form exactly as a level-by-level pass would, so the results are identical.
+    //
+    // With TEX_FILTER_FLOAT_MIPS the unquantized rows of each level are kept in a small ring of float
+    // scanlines instead, and the next level reads those. Rows only live until the next level has consumed
+    // them, so the extra memory is a few dozen scanlines per level.
+    constexpr size_t MIP_PYRAMID_BAND_ROWS = 32;
+        // Rows of the first mip level produced per sweep step
 
-        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
+    constexpr size_t MIP_PYRAMID_RING_ROWS = MIP_PYRAMID_BAND_ROWS + 4;
+        // Float scanlines retained per level with TEX_FILTER_FLOAT_MIPS
 
-        assert(levels > 1);
+    struct PyramidLevel
+    {
+        const Image*    src;
+        const Image*    dest;
+        size_t          width;
+        size_t          height;
+        size_t          nwidth;
+        size_t          nheight;
+        LinearFilter*   lfX;
+        LinearFilter*   lfY;
+        size_t          produced;
+        bool            rgba8;      // 8-bit integer box filter path
+        bool            srgb;
+        XMVECTOR*       ring;       // float copies of the source level's rows (or nullptr)
+        XMVECTOR*       destRing;   // float copies of this level's rows for the next level (or nullptr)
+    };
+
+    inline XMVECTOR* PyramidRingRow(XMVECTOR* ring, size_t width, size_t y) noexcept
+    {
+        return ring + width * (y % MIP_PYRAMID_RING_ROWS);
+    }
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
+    // First row of the source level needed for row y of the destination level
+    inline size_t PyramidFirstSourceRow(const PyramidLevel& lvl, size_t y, bool box) noexcept
+    {
+        if (box)
+            return (lvl.height > 1) ? (y << 1) : 0;
 
-        // Allocate temporary space (3 scanlines, plus X and Y filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 3), 16)));
-        if (!scanline)
-            return E_OUTOFMEMORY;
+        return std::min(lvl.lfY[y].u0, lvl.lfY[y].u1);
+    }
 
-        std::unique_ptr<LinearFilter[]> lf(new (std::nothrow) LinearFilter[width + height]);
-        if (!lf)
-            return E_OUTOFMEMORY;
+    // Last row of the source level needed for row y of the destination level
+    inline size_t PyramidSourceRow(const PyramidLevel& lvl, size_t y, bool box) noexcept
+    {
+        if (box)
+            return (lvl.height > 1) ? ((y << 1) + 1) : 0;
 
-        LinearFilter* lfX = lf.get();
-        LinearFilter* lfY = lf.get() + width;
+        return std::max(lvl.lfY[y].u0, lvl.lfY[y].u1);
+    }
 
-        XMVECTOR* target = scanline.get();
+    bool GeneratePyramidRow(const PyramidLevel& lvl, size_t y, bool box, TEX_FILTER_FLAGS filter, _Inout_ XMVECTOR* scratch) noexcept
+    {
+        const Image* src = lvl.src;
+        const Image* dest = lvl.dest;
 
-        XMVECTOR* row0 = target + width;
-        XMVECTOR* row1 = target + width * 2;
+        const uint8_t* pSrc = src->pixels;
+        const size_t rowPitch = src->rowPitch;
+        const size_t width = lvl.width;
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
+        XMVECTOR* target = scratch;
+        XMVECTOR* row0 = scratch + width;
+        XMVECTOR* row1 = scratch + width * 2;
+
+        if (box)
         {
-            // 2D linear filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+            // 2D box filter
+            const size_t u0 = y << 1;
+            const size_t u1 = (lvl.height > 1) ? (u0 + 1) : u0;
 
-            if (!src || !dest)
-                return E_POINTER;
+            if (lvl.rgba8)
+            {
+                BoxFilterRowRGBA8(dest->pixels + (dest->rowPitch * y), pSrc + (rowPitch * u0), pSrc + (rowPitch * u1), width, lvl.nwidth, lvl.srgb);
+                return true;
+            }
 
-            const uint8_t* pSrc = src->pixels;
-            uint8_t* pDest = dest->pixels;
+            if (lvl.ring)
+            {
+                row0 = PyramidRingRow(lvl.ring, width, u0);
+                row1 = PyramidRingRow(lvl.ring, width, u1);
+            }
+            else
+            {
+                if (!_LoadScanlineLinear(row0, width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
+                    return false;
 
-            size_t rowPitch = src->rowPitch;
+                if (u1 != u0)
+                {
+                    if (!_LoadScanlineLinear(row1, width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
+                        return false;
+                }
+                else
+                {
+                    row1 = row0;
+                }
+            }
 
-            size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            _CreateLinearFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, lfX);
+            const XMVECTOR* row2 = (width > 1) ? (row0 + 1) : row0;
+            const XMVECTOR* row3 = (width > 1) ? (row1 + 1) : row1;
 
-            size_t nheight = (height > 1) ? (height >> 1) : 1;
-            _CreateLinearFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, lfY);
+            for (size_t x = 0; x < lvl.nwidth; ++x)
+            {
+                size_t x2 = x << 1;
 
-#ifdef _DEBUG
-            memset(row0, 0xCD, sizeof(XMVECTOR)*width);
-            memset(row1, 0xDD, sizeof(XMVECTOR)*width);
-#endif
+                AVERAGE4(target[x], row0[x2], row1[x2], row2[x2], row3[x2])
+            }
+        }
+        else
+        {
+            // 2D linear filter
+            auto& toY = lvl.lfY[y];
 
-            size_t u0 = size_t(-1);
-            size_t u1 = size_t(-1);
+            if (lvl.ring)
+            {
+                row0 = PyramidRingRow(lvl.ring, width, toY.u0);
+                row1 = PyramidRingRow(lvl.ring, width, toY.u1);
+            }
+            else
+            {
+                if (!_LoadScanlineLinear(row0, width, pSrc + (rowPitch * toY.u0), rowPitch, src->format, filter))
+                    return false;
+
+                if (!_LoadScanlineLinear(row1, width, pSrc + (rowPitch * toY.u1), rowPitch, src->format, filter))
+                    return false;
+            }
 
-            for (size_t y = 0; y < nheight; ++y)
+            for (size_t x = 0; x < lvl.nwidth; ++x)
             {
-                auto& toY = lfY[y];
+                auto& toX = lvl.lfX[x];
 
-                if (toY.u0 != u0)
-                {
-                    if (toY.u0 != u1)
-                    {
-                        u0 = toY.u0;
+                BILINEAR_INTERPOLATE(target[x], toX, toY, row0, row1)
+            }
+        }
 
-                        if (!_LoadScanlineLinear(row0, width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
-                    else
-                    {
-                        u0 = u1;
-                        u1 = size_t(-1);
+        if (lvl.destRing)
+        {
+            // Keep the unquantized row, since storing converts target in-place
+            memcpy(PyramidRingRow(lvl.destRing, lvl.nwidth, y), target, sizeof(XMVECTOR) * lvl.nwidth);
+        }
+
+        return _StoreScanlineLinear(dest->pixels + (dest->rowPitch * y), dest->rowPitch, dest->format, target, lvl.nwidth, filter);
+    }
 
-                        std::swap(row0, row1);
+    HRESULT Generate2DMipsPyramid(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item, bool box) noexcept
+    {
+        if (!mipChain.GetImages())
+            return E_INVALIDARG;
+
+        // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
+
+        assert(levels > 1);
+
+        const size_t baseWidth = mipChain.GetMetadata().width;
+        const size_t baseHeight = mipChain.GetMetadata().height;
+
+        std::unique_ptr<PyramidLevel[]> chain(new (std::nothrow) PyramidLevel[levels]);
+        if (!chain)
+            return E_OUTOFMEMORY;
+
+        // Linear filters for every level are built up front (together less than twice the base size)
+        std::unique_ptr<LinearFilter[]> lf;
+        if (!box)
+        {
+            lf.reset(new (std::nothrow) LinearFilter[(baseWidth + baseHeight) * 2]);
+            if (!lf)
+                return E_OUTOFMEMORY;
+        }
+
+        LinearFilter* lfNext = lf.get();
+
+        bool srgb = false;
+        const bool rgba8 = box && UseBoxFilterRGBA8(mipChain.GetMetadata().format, filter, srgb);
+
+        // Float rings for every level except the last
+        ScopedAlignedArrayXMVECTOR rings;
+        if ((filter & TEX_FILTER_FLOAT_MIPS) && levels > 2)
+        {
+            size_t ringWidth = 0;
+            for (size_t level = 1, w = baseWidth; (level + 1) < levels; ++level)
+            {
+                w = (w > 1) ? (w >> 1) : 1;
+                ringWidth += w;
+            }
+
+            rings.reset(static_cast<XMVECTOR*>(_AlignedAlloc(sizeof(XMVECTOR) * ringWidth * MIP_PYRAMID_RING_ROWS, 16)));
+            if (!rings)
+                return E_OUTOFMEMORY;
+        }
+
+        XMVECTOR* ringNext = rings.get();
+
+        size_t width = baseWidth;
+        size_t height = baseHeight;
+        for (size_t level = 1; level < levels; ++level)
+        {
+            auto& lvl = chain[level];
+
+            lvl.src = mipChain.GetImage(level - 1, item, 0);
+            lvl.dest = mipChain.GetImage(level, item, 0);
+            if (!lvl.src || !lvl.dest)
+                return E_POINTER;
+
+            lvl.width = width;
+            lvl.height = height;
+            lvl.nwidth = (width > 1) ? (width >> 1) : 1;
+            lvl.nheight = (height > 1) ? (height >> 1) : 1;
+            lvl.lfX = lvl.lfY = nullptr;
+            lvl.produced = 0;
+            lvl.rgba8 = rgba8;
+            lvl.srgb = srgb;
+            lvl.ring = (level > 1) ? chain[level - 1].destRing : nullptr;
+            lvl.destRing = nullptr;
+
+            if (ringNext && (level + 1) < levels)
+            {
+                lvl.destRing = ringNext;
+                ringNext += lvl.nwidth * MIP_PYRAMID_RING_ROWS;
+            }
+
+            if (!box)
+            {
+                lvl.lfX = lfNext;
+                _CreateLinearFilter(width, lvl.nwidth, (filter & TEX_FILTER_WRAP_U) != 0, lvl.lfX);
+                lfNext += lvl.nwidth;
+
+                lvl.lfY = lfNext;
+                _CreateLinearFilter(height, lvl.nheight, (filter & TEX_FILTER_WRAP_V) != 0, lvl.lfY);
+                lfNext += lvl.nheight;
+            }
+
+            width = lvl.nwidth;
+            height = lvl.nheight;
+        }
+
+        const size_t threads = MipThreadCount();
+        const size_t stride = baseWidth * 3;
+
+        // Allocate temporary space (3 scanlines per thread)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
+        if (!scanline)
+            return E_OUTOFMEMORY;
+
+        auto& last = chain[levels - 1];
+        while (last.produced < last.nheight)
+        {
+            bool progress = false;
+
+            for (size_t level = 1; level < levels; ++level)
+            {
+                auto& lvl = chain[level];
+
+                // Find the rows whose source rows are already written
+                const size_t available = (level > 1) ? chain[level - 1].produced : lvl.height;
+                size_t limit = (level > 1) ? lvl.nheight : std::min(lvl.nheight, lvl.produced + MIP_PYRAMID_BAND_ROWS);
+
+                if (lvl.destRing)
+                {
+                    // Don't overwrite ring rows the next level still needs
+                    auto& next = chain[level + 1];
+                    if (next.produced < next.nheight)
+                    {
+                        limit = std::min(limit, PyramidFirstSourceRow(next, next.produced, box) + MIP_PYRAMID_RING_ROWS);
                     }
                 }
 
-                if (toY.u1 != u1)
-                {
-                    u1 = toY.u1;
+                size_t end = lvl.produced;
+                while (end < limit && PyramidSourceRow(lvl, end, box) < available)
+                    ++end;
 
-                    if (!_LoadScanlineLinear(row1, width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
-                        return E_FAIL;
-                }
+                if (end == lvl.produced)
+                    continue;
+
+                const size_t start = lvl.produced;
+                bool fail = false;
 
-                for (size_t x = 0; x < nwidth; ++x)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(threads)) if (UseRowBands(threads, lvl.nwidth, end - start))
+#endif
+                for (int y = static_cast<int>(start); y < static_cast<int>(end); ++y)
                 {
-                    auto& toX = lfX[x];
+                    if (fail)
+                        continue;
 
-                    BILINEAR_INTERPOLATE(target[x], toX, toY, row0, row1)
+                    if (!GeneratePyramidRow(lvl, size_t(y), box, filter, scanline.get() + stride * MipThreadIndex()))
+                        fail = true;
                 }
 
-                if (!_StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
+                if (fail)
                     return E_FAIL;
-                pDest += dest->rowPitch;
-            }
 
-            if (height > 1)
-                height >>= 1;
+                lvl.produced = end;
+                progress = true;
+            }
 
-            if (width > 1)
-                width >>= 1;
+            if (!progress)
+                return E_UNEXPECTED;
         }
 
         return S_OK;
     }
 
+
+    //--- 2D Box Filter ---
+    HRESULT Generate2DMipsBoxFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    {
+        if (!mipChain.GetImages())
+            return E_INVALIDARG;
+
+        if (!ispow2(mipChain.GetMetadata().width) || !ispow2(mipChain.GetMetadata().height))
+            return E_FAIL;
+
+        return Generate2DMipsPyramid(levels, filter, mipChain, item, true);
+    }
+
+
+    //--- 2D Linear Filter ---
+    HRESULT Generate2DMipsLinearFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    {
+        return Generate2DMipsPyramid(levels, filter, mipChain, item, false);
+    }
+
     //--- 2D Cubic Filter ---
     HRESULT Generate2DMipsCubicFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
     {
@@ -1184,8 +1621,11 @@ namespace
         size_t width = mipChain.GetMetadata().width;
         size_t height = mipChain.GetMetadata().height;
 
-        // Allocate temporary space (5 scanlines, plus X and Y filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 5), 16)));
+        const size_t threads = MipThreadCount();
+        const size_t stride = width * 5;
+
+        // Allocate temporary space (5 scanlines per thread, plus X and Y filters)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
 
@@ -1196,13 +1636,6 @@ namespace
         CubicFilter* cfX = cf.get();
         CubicFilter* cfY = cf.get() + width;
 
-        XMVECTOR* target = scanline.get();
-
-        XMVECTOR* row0 = target + width;
-        XMVECTOR* row1 = target + width * 2;
-        XMVECTOR* row2 = target + width * 3;
-        XMVECTOR* row3 = target + width * 4;
-
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
@@ -1224,128 +1657,162 @@ namespace
             size_t nheight = (height > 1) ? (height >> 1) : 1;
             _CreateCubicFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
 
-#ifdef _DEBUG
-            memset(row0, 0xCD, sizeof(XMVECTOR)*width);
-            memset(row1, 0xDD, sizeof(XMVECTOR)*width);
-            memset(row2, 0xED, sizeof(XMVECTOR)*width);
-            memset(row3, 0xFD, sizeof(XMVECTOR)*width);
+            bool fail = false;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(static_cast<int>(threads)) if (UseRowBands(threads, nwidth, nheight))
 #endif
+            {
+                XMVECTOR* target = scanline.get() + stride * MipThreadIndex();
 
-            size_t u0 = size_t(-1);
-            size_t u1 = size_t(-1);
-            size_t u2 = size_t(-1);
-            size_t u3 = size_t(-1);
+                XMVECTOR* row0 = target + width;
+                XMVECTOR* row1 = target + width * 2;
+                XMVECTOR* row2 = target + width * 3;
+                XMVECTOR* row3 = target + width * 4;
 
-            for (size_t y = 0; y < nheight; ++y)
-            {
-                auto& toY = cfY[y];
+#ifdef _DEBUG
+                memset(row0, 0xCD, sizeof(XMVECTOR)*width);
+                memset(row1, 0xDD, sizeof(XMVECTOR)*width);
+                memset(row2, 0xED, sizeof(XMVECTOR)*width);
+                memset(row3, 0xFD, sizeof(XMVECTOR)*width);
+#endif
 
-                // Scanline 1
-                if (toY.u0 != u0)
+                size_t u0 = size_t(-1);
+                size_t u1 = size_t(-1);
+                size_t u2 = size_t(-1);
+                size_t u3 = size_t(-1);
+
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+                for (int y = 0; y < static_cast<int>(nheight); ++y)
                 {
-                    if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
-                    {
-                        u0 = toY.u0;
+                    if (fail)
+                        continue;
 
-                        if (!_LoadScanlineLinear(row0, width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
-                            return E_FAIL;
-                    }
-                    else if (toY.u0 == u1)
-                    {
-                        u0 = u1;
-                        u1 = size_t(-1);
+                    auto& toY = cfY[y];
 
-                        std::swap(row0, row1);
-                    }
-                    else if (toY.u0 == u2)
+                    // Scanline 1
+                    if (toY.u0 != u0)
                     {
-                        u0 = u2;
-                        u2 = size_t(-1);
+                        if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
+                        {
+                            u0 = toY.u0;
 
-                        std::swap(row0, row2);
-                    }
-                    else if (toY.u0 == u3)
-                    {
-                        u0 = u3;
-                        u3 = size_t(-1);
+                            if (!_LoadScanlineLinear(row0, width, pSrc + (rowPitch * u0), rowPitch, src->format, filter))
+                            {
+                                fail = true;
+                                continue;
+                            }
+                        }
+                        else if (toY.u0 == u1)
+                        {
+                            u0 = u1;
+                            u1 = size_t(-1);
 
-                        std::swap(row0, row3);
-                    }
-                }
+                            std::swap(row0, row1);
+                        }
+                        else if (toY.u0 == u2)
+                        {
+                            u0 = u2;
+                            u2 = size_t(-1);
 
-                // Scanline 2
-                if (toY.u1 != u1)
-                {
-                    if (toY.u1 != u2 && toY.u1 != u3)
-                    {
-                        u1 = toY.u1;
+                            std::swap(row0, row2);
+                        }
+                        else if (toY.u0 == u3)
+                        {
+                            u0 = u3;
+                            u3 = size_t(-1);
 
-                        if (!_LoadScanlineLinear(row1, width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
-                            return E_FAIL;
+                            std::swap(row0, row3);
+                        }
                     }
-                    else if (toY.u1 == u2)
-                    {
-                        u1 = u2;
-                        u2 = size_t(-1);
 
-                        std::swap(row1, row2);
-                    }
-                    else if (toY.u1 == u3)
+                    // Scanline 2
+                    if (toY.u1 != u1)
                     {
-                        u1 = u3;
-                        u3 = size_t(-1);
+                        if (toY.u1 != u2 && toY.u1 != u3)
+                        {
+                            u1 = toY.u1;
 
-                        std::swap(row1, row3);
+                            if (!_LoadScanlineLinear(row1, width, pSrc + (rowPitch * u1), rowPitch, src->format, filter))
+                            {
+                                fail = true;
+                                continue;
+                            }
+                        }
+                        else if (toY.u1 == u2)
+                        {
+                            u1 = u2;
+                            u2 = size_t(-1);
+
+                            std::swap(row1, row2);
+                        }
+                        else if (toY.u1 == u3)
+                        {
+                            u1 = u3;
+                            u3 = size_t(-1);
+
+                            std::swap(row1, row3);
+                        }
                     }
-                }
 
-                // Scanline 3
-                if (toY.u2 != u2)
-                {
-                    if (toY.u2 != u3)
+                    // Scanline 3
+                    if (toY.u2 != u2)
                     {
-                        u2 = toY.u2;
+                        if (toY.u2 != u3)
+                        {
+                            u2 = toY.u2;
 
-                        if (!_LoadScanlineLinear(row2, width, pSrc + (rowPitch * u2), rowPitch, src->format, filter))
-                            return E_FAIL;
+                            if (!_LoadScanlineLinear(row2, width, pSrc + (rowPitch * u2), rowPitch, src->format, filter))
+                            {
+                                fail = true;
+                                continue;
+                            }
+                        }
+                        else
+                        {
+                            u2 = u3;
+                            u3 = size_t(-1);
+
+                            std::swap(row2, row3);
+                        }
                     }
-                    else
+
+                    // Scanline 4
+                    if (toY.u3 != u3)
                     {
-                        u2 = u3;
-                        u3 = size_t(-1);
+                        u3 = toY.u3;
 
-                        std::swap(row2, row3);
+                        if (!_LoadScanlineLinear(row3, width, pSrc + (rowPitch * u3), rowPitch, src->format, filter))
+                        {
+                            fail = true;
+                            continue;
+                        }
                     }
-                }
 
-                // Scanline 4
-                if (toY.u3 != u3)
-                {
-                    u3 = toY.u3;
-
-                    if (!_LoadScanlineLinear(row3, width, pSrc + (rowPitch * u3), rowPitch, src->format, filter))
-                        return E_FAIL;
-                }
+                    for (size_t x = 0; x < nwidth; ++x)
+                    {
+                        auto& toX = cfX[x];
 
-                for (size_t x = 0; x < nwidth; ++x)
-                {
-                    auto& toX = cfX[x];
+                        XMVECTOR C0, C1, C2, C3;
 
-                    XMVECTOR C0, C1, C2, C3;
+                        CUBIC_INTERPOLATE(C0, toX.x, row0[toX.u0], row0[toX.u1], row0[toX.u2], row0[toX.u3])
+                        CUBIC_INTERPOLATE(C1, toX.x, row1[toX.u0], row1[toX.u1], row1[toX.u2], row1[toX.u3])
+                        CUBIC_INTERPOLATE(C2, toX.x, row2[toX.u0], row2[toX.u1], row2[toX.u2], row2[toX.u3])
+                        CUBIC_INTERPOLATE(C3, toX.x, row3[toX.u0], row3[toX.u1], row3[toX.u2], row3[toX.u3])
 
-                    CUBIC_INTERPOLATE(C0, toX.x, row0[toX.u0], row0[toX.u1], row0[toX.u2], row0[toX.u3])
-                    CUBIC_INTERPOLATE(C1, toX.x, row1[toX.u0], row1[toX.u1], row1[toX.u2], row1[toX.u3])
-                    CUBIC_INTERPOLATE(C2, toX.x, row2[toX.u0], row2[toX.u1], row2[toX.u2], row2[toX.u3])
-                    CUBIC_INTERPOLATE(C3, toX.x, row3[toX.u0], row3[toX.u1], row3[toX.u2], row3[toX.u3])
+                        CUBIC_INTERPOLATE(target[x], toY.x, C0, C1, C2, C3)
+                    }
 
-                    CUBIC_INTERPOLATE(target[x], toY.x, C0, C1, C2, C3)
+                    if (!_StoreScanlineLinear(pDest + (dest->rowPitch * size_t(y)), dest->rowPitch, dest->format, target, nwidth, filter))
+                        fail = true;
                 }
-
-                if (!_StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                    return E_FAIL;
-                pDest += dest->rowPitch;
             }
 
+            if (fail)
+                return E_FAIL;
+
             if (height > 1)
                 height >>= 1;
 
@@ -1357,222 +1824,513 @@ namespace
     }
 
 
-    //--- 2D Triangle Filter ---
-    HRESULT Generate2DMipsTriangleFilter(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    //--- 2D separable filters (triangle, Lanczos, Mitchell, Kaiser) ---
+    bool UseSeparableFilter(unsigned long filter_select) noexcept
+    {
+        switch (filter_select)
+        {
+        case TEX_FILTER_TRIANGLE:
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_MITCHELL:
+        case TEX_FILTER_KAISER:
+            return true;
+
+        default:
+            return false;
+        }
+    }
+
+    // Each level is resampled from the one above it, so these filters are only parallelized across items
+    HRESULT Generate2DMipsSeparable(size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
     {
         if (!mipChain.GetImages())
             return E_INVALIDARG;
 
-        using namespace TriangleFilter;
-
         // This assumes that the base image is already placed into the mipChain at the top level... (see _Setup2DMips)
 
         assert(levels > 1);
 
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
+        for (size_t level = 1; level < levels; ++level)
+        {
+            const Image* src = mipChain.GetImage(level - 1, item, 0);
+            const Image* dest = mipChain.GetImage(level, item, 0);
+            if (!src || !dest)
+                return E_POINTER;
 
-        // Allocate initial temporary space (1 scanline, accumulation rows, plus X and Y filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * width, 16)));
-        if (!scanline)
-            return E_OUTOFMEMORY;
+            HRESULT hr = _ResizeSeparable(*src, filter, *dest);
+            if (FAILED(hr))
+                return hr;
+        }
 
-        std::unique_ptr<TriangleRow[]> rowActive(new (std::nothrow) TriangleRow[height]);
-        if (!rowActive)
-            return E_OUTOFMEMORY;
+        return S_OK;
+    }
 
-        TriangleRow * rowFree = nullptr;
 
-        std::unique_ptr<Filter> tfX, tfY;
+    //--- 2D custom filter dispatch ---
+    HRESULT Generate2DMips(unsigned long filter_select, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t item) noexcept
+    {
+        switch (filter_select)
+        {
+        case TEX_FILTER_BOX:
+            return Generate2DMipsBoxFilter(levels, filter, mipChain, item);
 
-        XMVECTOR* row = scanline.get();
+        case TEX_FILTER_POINT:
+            return Generate2DMipsPointFilter(levels, mipChain, item);
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
-        {
-            // 2D triangle filter
-            const Image* src = mipChain.GetImage(level - 1, item, 0);
-            const Image* dest = mipChain.GetImage(level, item, 0);
+        case TEX_FILTER_LINEAR:
+            return Generate2DMipsLinearFilter(levels, filter, mipChain, item);
 
-            if (!src || !dest)
-                return E_POINTER;
+        case TEX_FILTER_CUBIC:
+            return Generate2DMipsCubicFilter(levels, filter, mipChain, item);
 
-            const uint8_t* pSrc = src->pixels;
-            size_t rowPitch = src->rowPitch;
-            const uint8_t* pEndSrc = pSrc + rowPitch * height;
+        case TEX_FILTER_TRIANGLE:
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_MITCHELL:
+        case TEX_FILTER_KAISER:
+            return Generate2DMipsSeparable(levels, filter, mipChain, item);
 
-            uint8_t* pDest = dest->pixels;
+        default:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+    }
 
-            size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            HRESULT hr = _Create(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, tfX);
+
+    //-------------------------------------------------------------------------------------
+    // Update (1D/2D) mip-map helpers (custom filtering)
+    //-------------------------------------------------------------------------------------
+    constexpr size_t MIP_UPDATE_MAX_RECTS = 32;
+        // Dirty rectangles tracked per level before they are merged into their bounding box
+
+    struct MipUpdateLevel
+    {
+        const Image*                        src;
+        const Image*                        dest;
+        unsigned long                       filter_select;
+        size_t                              width;
+        size_t                              height;
+        size_t                              nwidth;
+        size_t                              nheight;
+        size_t                              bpp;        // 0 if only whole rows can be loaded and stored
+        bool                                rgba8;      // 8-bit integer box filter path
+        bool                                srgb;
+        size_t                              tapsX;
+        size_t                              tapsY;
+        std::unique_ptr<uint32_t[]>         indexX;     // source columns read by each destination column
+        std::unique_ptr<uint32_t[]>         indexY;     // source rows read by each destination row
+        std::unique_ptr<LinearFilter[]>     lf;         // nwidth X filters followed by nheight Y filters
+        std::unique_ptr<CubicFilter[]>      cf;
+    };
+
+    // Builds the filter tables for one level, matching those used by Generate2DMips
+    HRESULT SetupMipUpdateLevel(
+        unsigned long filter_select,
+        TEX_FILTER_FLAGS filter,
+        const Image* src,
+        const Image* dest,
+        _Out_ MipUpdateLevel& lvl) noexcept
+    {
+        lvl.src = src;
+        lvl.dest = dest;
+        lvl.filter_select = filter_select;
+        lvl.width = src->width;
+        lvl.height = src->height;
+        lvl.nwidth = dest->width;
+        lvl.nheight = dest->height;
+        lvl.bpp = _ScanlineSpanPixelBytes(src->format);
+        lvl.srgb = false;
+        lvl.rgba8 = (filter_select == TEX_FILTER_BOX) && UseBoxFilterRGBA8(src->format, filter, lvl.srgb);
+        lvl.tapsX = lvl.tapsY = 0;
+        lvl.lf.reset();
+        lvl.cf.reset();
+
+        if (UseSeparableFilter(filter_select))
+        {
+            HRESULT hr = _GetResampleTaps(lvl.width, lvl.nwidth, filter, false, lvl.tapsX, lvl.indexX);
             if (FAILED(hr))
                 return hr;
 
-            size_t nheight = (height > 1) ? (height >> 1) : 1;
-            hr = _Create(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, tfY);
-            if (FAILED(hr))
-                return hr;
+            return _GetResampleTaps(lvl.height, lvl.nheight, filter, true, lvl.tapsY, lvl.indexY);
+        }
+
+        switch (filter_select)
+        {
+        case TEX_FILTER_POINT:
+        case TEX_FILTER_BOX:
+            lvl.tapsX = lvl.tapsY = (filter_select == TEX_FILTER_POINT) ? 1 : 2;
+            break;
+
+        case TEX_FILTER_LINEAR:
+            lvl.tapsX = lvl.tapsY = 2;
+            lvl.lf.reset(new (std::nothrow) LinearFilter[lvl.nwidth + lvl.nheight]);
+            if (!lvl.lf)
+                return E_OUTOFMEMORY;
+
+            _CreateLinearFilter(lvl.width, lvl.nwidth, (filter & TEX_FILTER_WRAP_U) != 0, lvl.lf.get());
+            _CreateLinearFilter(lvl.height, lvl.nheight, (filter & TEX_FILTER_WRAP_V) != 0, lvl.lf.get() + lvl.nwidth);
+            break;
+
+        case TEX_FILTER_CUBIC:
+            lvl.tapsX = lvl.tapsY = 4;
+            lvl.cf.reset(new (std::nothrow) CubicFilter[lvl.nwidth + lvl.nheight]);
+            if (!lvl.cf)
+                return E_OUTOFMEMORY;
+
+            _CreateCubicFilter(lvl.width, lvl.nwidth, (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, lvl.cf.get());
+            _CreateCubicFilter(lvl.height, lvl.nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, lvl.cf.get() + lvl.nwidth);
+            break;
+
+        default:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+
+        lvl.indexX.reset(new (std::nothrow) uint32_t[lvl.nwidth * lvl.tapsX]);
+        lvl.indexY.reset(new (std::nothrow) uint32_t[lvl.nheight * lvl.tapsY]);
+        if (!lvl.indexX || !lvl.indexY)
+            return E_OUTOFMEMORY;
+
+        for (size_t axis = 0; axis < 2; ++axis)
+        {
+            const size_t size = (axis) ? lvl.height : lvl.width;
+            const size_t nsize = (axis) ? lvl.nheight : lvl.nwidth;
+            uint32_t* index = (axis) ? lvl.indexY.get() : lvl.indexX.get();
+
+            for (size_t u = 0; u < nsize; ++u)
+            {
+                switch (filter_select)
+                {
+                case TEX_FILTER_POINT:
+                    index[u] = static_cast<uint32_t>((((size << 16) / nsize) * u) >> 16);
+                    break;
+
+                case TEX_FILTER_BOX:
+                    index[u * 2] = static_cast<uint32_t>((size > 1) ? (u << 1) : 0);
+                    index[u * 2 + 1] = static_cast<uint32_t>((size > 1) ? ((u << 1) + 1) : 0);
+                    break;
+
+                case TEX_FILTER_LINEAR:
+                {
+                    auto& lf = lvl.lf[(axis) ? (lvl.nwidth + u) : u];
+                    index[u * 2] = static_cast<uint32_t>(lf.u0);
+                    index[u * 2 + 1] = static_cast<uint32_t>(lf.u1);
+                    break;
+                }
+
+                default:
+                {
+                    auto& cf = lvl.cf[(axis) ? (lvl.nwidth + u) : u];
+                    index[u * 4] = static_cast<uint32_t>(cf.u0);
+                    index[u * 4 + 1] = static_cast<uint32_t>(cf.u1);
+                    index[u * 4 + 2] = static_cast<uint32_t>(cf.u2);
+                    index[u * 4 + 3] = static_cast<uint32_t>(cf.u3);
+                    break;
+                }
+                }
+            }
+        }
+
+        return S_OK;
+    }
+
+    // Finds the destination coordinates along one axis that read any source coordinate in [first, last).
+    // With wrapping this can be two runs; anything beyond the first run is returned as its bounding run.
+    size_t FindMipUpdateRuns(
+        _In_reads_(nsize * taps) const uint32_t* index,
+        size_t taps,
+        size_t nsize,
+        size_t first,
+        size_t last,
+        _Out_writes_(2) size_t* starts,
+        _Out_writes_(2) size_t* ends) noexcept
+    {
+        size_t count = 0;
+        bool open = false;
+
+        for (size_t u = 0; u < nsize; ++u)
+        {
+            bool hit = false;
+            for (size_t t = 0; t < taps && !hit; ++t)
+            {
+                hit = (index[u * taps + t] >= first) && (index[u * taps + t] < last);
+            }
+
+            if (!hit)
+            {
+                open = false;
+                continue;
+            }
+
+            if (!open && count < 2)
+            {
+                starts[count++] = u;
+            }
+
+            open = true;
+            ends[count - 1] = u + 1;
+        }
+
+        return count;
+    }
+
+    // Range of source columns read by destination columns [x0, x1)
+    void GetMipUpdateSpan(const MipUpdateLevel& lvl, size_t x0, size_t x1, _Out_ size_t& sx0, _Out_ size_t& sx1) noexcept
+    {
+        sx0 = lvl.width;
+        sx1 = 0;
+        for (size_t i = x0 * lvl.tapsX; i < x1 * lvl.tapsX; ++i)
+        {
+            sx0 = std::min<size_t>(sx0, lvl.indexX[i]);
+            sx1 = std::max<size_t>(sx1, size_t(lvl.indexX[i]) + 1);
+        }
+    }
+
+    bool LoadMipUpdateRow(
+        const MipUpdateLevel& lvl,
+        size_t v,
+        size_t sx0,
+        size_t sx1,
+        TEX_FILTER_FLAGS filter,
+        _Out_writes_(lvl.width) XMVECTOR* row) noexcept
+    {
+        const Image* src = lvl.src;
+        const uint8_t* pSrc = src->pixels + (src->rowPitch * v);
+        const bool point = (lvl.filter_select == TEX_FILTER_POINT);
+
+        if (sx0 > 0 || sx1 < lvl.width)
+        {
+            // Source columns are kept at their own position in the row
+            return (point)
+                ? _LoadScanline(row + sx0, sx1 - sx0, pSrc + (sx0 * lvl.bpp), (sx1 - sx0) * lvl.bpp, src->format)
+                : _LoadScanlineLinear(row + sx0, sx1 - sx0, pSrc + (sx0 * lvl.bpp), (sx1 - sx0) * lvl.bpp, src->format, filter);
+        }
+
+        return (point)
+            ? _LoadScanline(row, lvl.width, pSrc, src->rowPitch, src->format)
+            : _LoadScanlineLinear(row, lvl.width, pSrc, src->rowPitch, src->format, filter);
+    }
+
+    // Regenerates destination row y between columns x0 and x1 using the same math as Generate2DMips
+    bool UpdateMipRow(
+        const MipUpdateLevel& lvl,
+        size_t y,
+        size_t x0,
+        size_t x1,
+        size_t sx0,
+        size_t sx1,
+        TEX_FILTER_FLAGS filter,
+        _Inout_ XMVECTOR* scratch) noexcept
+    {
+        const Image* src = lvl.src;
+        const Image* dest = lvl.dest;
+        const size_t width = lvl.width;
+
+        XMVECTOR* target = scratch;
+        XMVECTOR* row0 = scratch + width;
+        XMVECTOR* row1 = scratch + width * 2;
+        XMVECTOR* row2 = scratch + width * 3;
+        XMVECTOR* row3 = scratch + width * 4;
 
-#ifdef _DEBUG
-            memset(row, 0xCD, sizeof(XMVECTOR)*width);
-#endif
+        const uint32_t* iy = lvl.indexY.get() + y * lvl.tapsY;
 
-            auto xFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfX.get()) + tfX->sizeInBytes);
-            auto yFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfY.get()) + tfY->sizeInBytes);
+        switch (lvl.filter_select)
+        {
+        case TEX_FILTER_POINT:
+            if (!LoadMipUpdateRow(lvl, iy[0], sx0, sx1, filter, row0))
+                return false;
 
-            // Count times rows get written (and clear out any leftover accumulation rows from last miplevel)
-            for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+            for (size_t x = x0; x < x1; ++x)
             {
-                for (size_t j = 0; j < yFrom->count; ++j)
-                {
-                    size_t v = yFrom->to[j].u;
-                    assert(v < nheight);
-                    TriangleRow* rowAcc = &rowActive[v];
+                target[x] = row0[lvl.indexX[x]];
+            }
+            break;
 
-                    ++rowAcc->remaining;
+        case TEX_FILTER_BOX:
+        {
+            const size_t u0 = iy[0];
+            const size_t u1 = iy[1];
 
-                    if (rowAcc->scanline)
-                    {
-                        memset(rowAcc->scanline.get(), 0, sizeof(XMVECTOR) * nwidth);
-                    }
-                }
+            if (lvl.rgba8)
+            {
+                const uint8_t* pSrc = src->pixels + (sx0 * 4);
+                BoxFilterRowRGBA8(dest->pixels + (dest->rowPitch * y) + (x0 * 4),
+                    pSrc + (src->rowPitch * u0), pSrc + (src->rowPitch * u1), width, x1 - x0, lvl.srgb);
+                return true;
+            }
+
+            if (!LoadMipUpdateRow(lvl, u0, sx0, sx1, filter, row0))
+                return false;
 
-                yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
+            if (u1 != u0)
+            {
+                if (!LoadMipUpdateRow(lvl, u1, sx0, sx1, filter, row1))
+                    return false;
+            }
+            else
+            {
+                row1 = row0;
             }
 
-            // Filter image
-            for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+            row2 = (width > 1) ? (row0 + 1) : row0;
+            row3 = (width > 1) ? (row1 + 1) : row1;
+
+            for (size_t x = x0; x < x1; ++x)
             {
-                // Create accumulation rows as needed
-                for (size_t j = 0; j < yFrom->count; ++j)
-                {
-                    size_t v = yFrom->to[j].u;
-                    assert(v < nheight);
-                    TriangleRow* rowAcc = &rowActive[v];
+                size_t x2 = x << 1;
 
-                    if (!rowAcc->scanline)
-                    {
-                        if (rowFree)
-                        {
-                            // Steal and reuse scanline from 'free row' list
-                            // (it will always be at least as wide as nwidth due to loop decending order)
-                            assert(rowFree->scanline != nullptr);
-                            rowAcc->scanline.reset(rowFree->scanline.release());
-                            rowFree = rowFree->next;
-                        }
-                        else
-                        {
-                            rowAcc->scanline.reset(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * nwidth, 16)));
-                            if (!rowAcc->scanline)
-                                return E_OUTOFMEMORY;
-                        }
+                AVERAGE4(target[x], row0[x2], row1[x2], row2[x2], row3[x2])
+            }
+            break;
+        }
 
-                        memset(rowAcc->scanline.get(), 0, sizeof(XMVECTOR) * nwidth);
-                    }
-                }
+        case TEX_FILTER_LINEAR:
+        {
+            auto& toY = lvl.lf[lvl.nwidth + y];
 
-                // Load source scanline
-                if ((pSrc + rowPitch) > pEndSrc)
-                    return E_FAIL;
+            if (!LoadMipUpdateRow(lvl, toY.u0, sx0, sx1, filter, row0)
+                || !LoadMipUpdateRow(lvl, toY.u1, sx0, sx1, filter, row1))
+                return false;
 
-                if (!_LoadScanlineLinear(row, width, pSrc, rowPitch, src->format, filter))
-                    return E_FAIL;
+            for (size_t x = x0; x < x1; ++x)
+            {
+                auto& toX = lvl.lf[x];
 
-                pSrc += rowPitch;
+                BILINEAR_INTERPOLATE(target[x], toX, toY, row0, row1)
+            }
+            break;
+        }
 
-                // Process row
-                size_t x = 0;
-                for (FilterFrom* xFrom = tfX->from; xFrom < xFromEnd; ++x)
-                {
-                    for (size_t j = 0; j < yFrom->count; ++j)
-                    {
-                        size_t v = yFrom->to[j].u;
-                        assert(v < nheight);
-                        float yweight = yFrom->to[j].weight;
+        case TEX_FILTER_CUBIC:
+        {
+            auto& toY = lvl.cf[lvl.nwidth + y];
 
-                        XMVECTOR* accPtr = rowActive[v].scanline.get();
-                        if (!accPtr)
-                            return E_POINTER;
+            if (!LoadMipUpdateRow(lvl, toY.u0, sx0, sx1, filter, row0)
+                || !LoadMipUpdateRow(lvl, toY.u1, sx0, sx1, filter, row1)
+                || !LoadMipUpdateRow(lvl, toY.u2, sx0, sx1, filter, row2)
+                || !LoadMipUpdateRow(lvl, toY.u3, sx0, sx1, filter, row3))
+                return false;
 
-                        for (size_t k = 0; k < xFrom->count; ++k)
-                        {
-                            size_t u = xFrom->to[k].u;
-                            assert(u < nwidth);
+            for (size_t x = x0; x < x1; ++x)
+            {
+                auto& toX = lvl.cf[x];
 
-                            XMVECTOR weight = XMVectorReplicate(yweight * xFrom->to[k].weight);
+                XMVECTOR C0, C1, C2, C3;
 
-                            assert(x < width);
-                            accPtr[u] = XMVectorMultiplyAdd(row[x], weight, accPtr[u]);
-                        }
-                    }
+                CUBIC_INTERPOLATE(C0, toX.x, row0[toX.u0], row0[toX.u1], row0[toX.u2], row0[toX.u3])
+                CUBIC_INTERPOLATE(C1, toX.x, row1[toX.u0], row1[toX.u1], row1[toX.u2], row1[toX.u3])
+                CUBIC_INTERPOLATE(C2, toX.x, row2[toX.u0], row2[toX.u1], row2[toX.u2], row2[toX.u3])
+                CUBIC_INTERPOLATE(C3, toX.x, row3[toX.u0], row3[toX.u1], row3[toX.u2], row3[toX.u3])
 
-                    xFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(xFrom) + xFrom->sizeInBytes);
-                }
+                CUBIC_INTERPOLATE(target[x], toY.x, C0, C1, C2, C3)
+            }
+            break;
+        }
 
-                // Write completed accumulation rows
-                for (size_t j = 0; j < yFrom->count; ++j)
-                {
-                    size_t v = yFrom->to[j].u;
-                    assert(v < nheight);
-                    TriangleRow* rowAcc = &rowActive[v];
+        default:
+            return false;
+        }
 
-                    assert(rowAcc->remaining > 0);
-                    --rowAcc->remaining;
+        uint8_t* pDest = dest->pixels + (dest->rowPitch * y);
+        if (x0 > 0 || x1 < lvl.nwidth)
+        {
+            pDest += x0 * lvl.bpp;
+            const size_t size = (x1 - x0) * lvl.bpp;
 
-                    if (!rowAcc->remaining)
-                    {
-                        XMVECTOR* pAccSrc = rowAcc->scanline.get();
-                        if (!pAccSrc)
-                            return E_POINTER;
+            return (lvl.filter_select == TEX_FILTER_POINT)
+                ? _StoreScanline(pDest, size, dest->format, target + x0, x1 - x0)
+                : _StoreScanlineLinear(pDest, size, dest->format, target + x0, x1 - x0, filter);
+        }
 
-                        switch (dest->format)
-                        {
-                        case DXGI_FORMAT_R10G10B10A2_UNORM:
-                        case DXGI_FORMAT_R10G10B10A2_UINT:
-                        {
-                            // Need to slightly bias results for floating-point error accumulation which can
-                            // be visible with harshly quantized values
-                            static const XMVECTORF32 Bias = { { { 0.f, 0.f, 0.f, 0.1f } } };
+        return (lvl.filter_select == TEX_FILTER_POINT)
+            ? _StoreScanline(pDest, dest->rowPitch, dest->format, target, lvl.nwidth)
+            : _StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, lvl.nwidth, filter);
+    }
 
-                            XMVECTOR* ptr = pAccSrc;
-                            for (size_t i = 0; i < dest->width; ++i, ++ptr)
-                            {
-                                *ptr = XMVectorAdd(*ptr, Bias);
-                            }
-                        }
-                        break;
+    HRESULT UpdateMipRect(
+        const MipUpdateLevel& lvl,
+        const Rect& rect,
+        TEX_FILTER_FLAGS filter,
+        size_t threads,
+        _Inout_ XMVECTOR* scanline,
+        size_t stride) noexcept
+    {
+        if (UseSeparableFilter(lvl.filter_select))
+            return _ResizeSeparable(*lvl.src, filter, *lvl.dest, &rect);
 
-                        default:
-                            break;
-                        }
+        size_t x0 = rect.x;
+        size_t x1 = rect.x + rect.w;
+        if (!lvl.bpp)
+        {
+            // Partial rows can't be stored, so whole rows are regenerated (pixels outside the rect come out unchanged)
+            x0 = 0;
+            x1 = lvl.nwidth;
+        }
 
-                        // This performs any required clamping
-                        if (!_StoreScanlineLinear(pDest + (dest->rowPitch * v), dest->rowPitch, dest->format, pAccSrc, dest->width, filter))
-                            return E_FAIL;
+        size_t sx0, sx1;
+        GetMipUpdateSpan(lvl, x0, x1, sx0, sx1);
 
-                        // Put row on freelist to reuse it's allocated scanline
-                        rowAcc->next = rowFree;
-                        rowFree = rowAcc;
-                    }
-                }
+        if (!lvl.bpp)
+        {
+            sx0 = 0;
+            sx1 = lvl.width;
+        }
 
-                yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
-            }
+        bool fail = false;
 
-            if (height > 1)
-                height >>= 1;
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(threads)) if (UseRowBands(threads, x1 - x0, rect.h))
+#endif
+        for (int y = static_cast<int>(rect.y); y < static_cast<int>(rect.y + rect.h); ++y)
+        {
+            if (fail)
+                continue;
 
-            if (width > 1)
-                width >>= 1;
+            if (!UpdateMipRow(lvl, size_t(y), x0, x1, sx0, sx1, filter, scanline + stride * MipThreadIndex()))
+                fail = true;
         }
 
-        return S_OK;
+        return (fail) ? E_FAIL : S_OK;
+    }
+
+    // Collapses a list of rectangles into their bounding box
+    Rect BoundMipUpdateRects(_In_reads_(count) const Rect* rects, size_t count) noexcept
+    {
+        size_t x0 = rects[0].x;
+        size_t y0 = rects[0].y;
+        size_t x1 = rects[0].x + rects[0].w;
+        size_t y1 = rects[0].y + rects[0].h;
+
+        for (size_t j = 1; j < count; ++j)
+        {
+            x0 = std::min(x0, rects[j].x);
+            y0 = std::min(y0, rects[j].y);
+            x1 = std::max(x1, rects[j].x + rects[j].w);
+            y1 = std::max(y1, rects[j].y + rects[j].h);
+        }
+
+        return Rect(x0, y0, x1 - x0, y1 - y0);
     }
 
 
     //-------------------------------------------------------------------------------------
     // Generate volume mip-map helpers
     //-------------------------------------------------------------------------------------
+
+    // Number of threads for destination slices, limited so the per-thread scratch plus any fixed
+    // scratch stays within the budget (0 means no limit)
+    HRESULT Mip3DThreadCount(size_t bytesPerThread, size_t fixedBytes, size_t scratchBudget, _Out_ size_t& threads) noexcept
+    {
+        threads = MipThreadCount();
+
+        if (scratchBudget)
+        {
+            if (fixedBytes >= scratchBudget || bytesPerThread > (scratchBudget - fixedBytes))
+                return HRESULT_FROM_WIN32(ERROR_NOT_ENOUGH_MEMORY);
+
+            threads = std::max<size_t>(1, std::min(threads, (scratchBudget - fixedBytes) / bytesPerThread));
+        }
+
+        return S_OK;
+    }
+
     HRESULT Setup3DMips(
         _In_reads_(depth) const Image* baseImages,
         size_t depth,
@@ -1627,8 +2385,59 @@ namespace
     }
 
 
+    //--- 3D point filter for one destination slice ---
+    HRESULT PointFilterSlice(const Image& src, const Image& dest, size_t width, size_t height, _Inout_ XMVECTOR* scratch) noexcept
+    {
+        XMVECTOR* target = scratch;
+        XMVECTOR* row = scratch + width;
+
+#ifdef _DEBUG
+        memset(row, 0xCD, sizeof(XMVECTOR)*width);
+#endif
+
+        const uint8_t* pSrc = src.pixels;
+        uint8_t* pDest = dest.pixels;
+
+        size_t rowPitch = src.rowPitch;
+
+        size_t nwidth = (width > 1) ? (width >> 1) : 1;
+        size_t nheight = (height > 1) ? (height >> 1) : 1;
+
+        size_t xinc = (width << 16) / nwidth;
+        size_t yinc = (height << 16) / nheight;
+
+        size_t lasty = size_t(-1);
+
+        size_t sy = 0;
+        for (size_t y = 0; y < nheight; ++y)
+        {
+            if ((lasty ^ sy) >> 16)
+            {
+                if (!_LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src.format))
+                    return E_FAIL;
+                lasty = sy;
+            }
+
+            size_t sx = 0;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                target[x] = row[sx >> 16];
+                sx += xinc;
+            }
+
+            if (!_StoreScanline(pDest, dest.rowPitch, dest.format, target, nwidth))
+                return E_FAIL;
+            pDest += dest.rowPitch;
+
+            sy += yinc;
+        }
+
+        return S_OK;
+    }
+
+
     //--- 3D Point Filter ---
-    HRESULT Generate3DMipsPointFilter(size_t depth, size_t levels, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsPointFilter(size_t depth, size_t levels, const ScratchImage& mipChain, size_t scratchBudget) noexcept
     {
         if (!depth || !mipChain.GetImages())
             return E_INVALIDARG;
@@ -1640,22 +2449,21 @@ namespace
         size_t width = mipChain.GetMetadata().width;
         size_t height = mipChain.GetMetadata().height;
 
-        // Allocate temporary space (2 scanlines)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 2), 16)));
-        if (!scanline)
-            return E_OUTOFMEMORY;
+        const size_t stride = width * 2;
 
-        XMVECTOR* target = scanline.get();
+        size_t threads = 0;
+        HRESULT hr = Mip3DThreadCount(sizeof(XMVECTOR) * stride, 0, scratchBudget, threads);
+        if (FAILED(hr))
+            return hr;
 
-        XMVECTOR* row = target + width;
+        // Allocate temporary space (2 scanlines per thread)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
+        if (!scanline)
+            return E_OUTOFMEMORY;
 
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
         {
-#ifdef _DEBUG
-            memset(row, 0xCD, sizeof(XMVECTOR)*width);
-#endif
-
             if (depth > 1)
             {
                 // 3D point filter
@@ -1663,54 +2471,28 @@ namespace
 
                 size_t zinc = (depth << 16) / ndepth;
 
-                size_t sz = 0;
-                for (size_t slice = 0; slice < ndepth; ++slice)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(threads)) if (threads > 1) schedule(static)
+#endif
+                for (int slice = 0; slice < static_cast<int>(ndepth); ++slice)
                 {
-                    const Image* src = mipChain.GetImage(level - 1, 0, (sz >> 16));
-                    const Image* dest = mipChain.GetImage(level, 0, slice);
-
-                    if (!src || !dest)
-                        return E_POINTER;
-
-                    const uint8_t* pSrc = src->pixels;
-                    uint8_t* pDest = dest->pixels;
+                    const Image* src = mipChain.GetImage(level - 1, 0, ((zinc * size_t(slice)) >> 16));
+                    const Image* dest = mipChain.GetImage(level, 0, size_t(slice));
 
-                    size_t rowPitch = src->rowPitch;
-
-                    size_t nwidth = (width > 1) ? (width >> 1) : 1;
-                    size_t nheight = (height > 1) ? (height >> 1) : 1;
-
-                    size_t xinc = (width << 16) / nwidth;
-                    size_t yinc = (height << 16) / nheight;
-
-                    size_t lasty = size_t(-1);
-
-                    size_t sy = 0;
-                    for (size_t y = 0; y < nheight; ++y)
+                    HRESULT hrSlice = (src && dest)
+                        ? PointFilterSlice(*src, *dest, width, height, scanline.get() + stride * MipThreadIndex())
+                        : E_POINTER;
+                    if (FAILED(hrSlice))
                     {
-                        if ((lasty ^ sy) >> 16)
-                        {
-                            if (!_LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src->format))
-                                return E_FAIL;
-                            lasty = sy;
-                        }
-
-                        size_t sx = 0;
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            target[x] = row[sx >> 16];
-                            sx += xinc;
-                        }
-
-                        if (!_StoreScanline(pDest, dest->rowPitch, dest->format, target, nwidth))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
-
-                        sy += yinc;
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        hr = hrSlice;
                     }
-
-                    sz += zinc;
                 }
+
+                if (FAILED(hr))
+                    return hr;
             }
             else
             {
@@ -1721,52 +2503,106 @@ namespace
                 if (!src || !dest)
                     return E_POINTER;
 
-                const uint8_t* pSrc = src->pixels;
-                uint8_t* pDest = dest->pixels;
+                hr = PointFilterSlice(*src, *dest, width, height, scanline.get());
+                if (FAILED(hr))
+                    return hr;
+            }
 
-                size_t rowPitch = src->rowPitch;
+            if (height > 1)
+                height >>= 1;
 
-                size_t nwidth = (width > 1) ? (width >> 1) : 1;
-                size_t nheight = (height > 1) ? (height >> 1) : 1;
+            if (width > 1)
+                width >>= 1;
+
+            if (depth > 1)
+                depth >>= 1;
+        }
 
-                size_t xinc = (width << 16) / nwidth;
-                size_t yinc = (height << 16) / nheight;
+        return S_OK;
+    }
 
-                size_t lasty = size_t(-1);
 
-                size_t sy = 0;
-                for (size_t y = 0; y < nheight; ++y)
-                {
-                    if ((lasty ^ sy) >> 16)
-                    {
-                        if (!_LoadScanline(row, width, pSrc + (rowPitch * (sy >> 16)), rowPitch, src->format))
-                            return E_FAIL;
-                        lasty = sy;
-                    }
+    //--- 3D box filter for one destination slice ---
+    HRESULT BoxFilterSlice(
+        const Image& srca,
+        const Image& srcb,
+        const Image& dest,
+        size_t width,
+        size_t height,
+        TEX_FILTER_FLAGS filter,
+        _Inout_ XMVECTOR* scratch) noexcept
+    {
+        XMVECTOR* target = scratch;
 
-                    size_t sx = 0;
-                    for (size_t x = 0; x < nwidth; ++x)
-                    {
-                        target[x] = row[sx >> 16];
-                        sx += xinc;
-                    }
+        XMVECTOR* urow0 = scratch + width;
+        XMVECTOR* urow1 = scratch + width * 2;
+        XMVECTOR* vrow0 = scratch + width * 3;
+        XMVECTOR* vrow1 = scratch + width * 4;
 
-                    if (!_StoreScanline(pDest, dest->rowPitch, dest->format, target, nwidth))
-                        return E_FAIL;
-                    pDest += dest->rowPitch;
+        if (height <= 1)
+        {
+            urow1 = urow0;
+            vrow1 = vrow0;
+        }
 
-                    sy += yinc;
-                }
+        const XMVECTOR* urow2 = urow0 + 1;
+        const XMVECTOR* urow3 = urow1 + 1;
+        const XMVECTOR* vrow2 = vrow0 + 1;
+        const XMVECTOR* vrow3 = vrow1 + 1;
+
+        if (width <= 1)
+        {
+            urow2 = urow0;
+            urow3 = urow1;
+            vrow2 = vrow0;
+            vrow3 = vrow1;
+        }
+
+        const uint8_t* pSrc1 = srca.pixels;
+        const uint8_t* pSrc2 = srcb.pixels;
+        uint8_t* pDest = dest.pixels;
+
+        size_t aRowPitch = srca.rowPitch;
+        size_t bRowPitch = srcb.rowPitch;
+
+        size_t nwidth = (width > 1) ? (width >> 1) : 1;
+        size_t nheight = (height > 1) ? (height >> 1) : 1;
+
+        for (size_t y = 0; y < nheight; ++y)
+        {
+            if (!_LoadScanlineLinear(urow0, width, pSrc1, aRowPitch, srca.format, filter))
+                return E_FAIL;
+            pSrc1 += aRowPitch;
+
+            if (urow0 != urow1)
+            {
+                if (!_LoadScanlineLinear(urow1, width, pSrc1, aRowPitch, srca.format, filter))
+                    return E_FAIL;
+                pSrc1 += aRowPitch;
             }
 
-            if (height > 1)
-                height >>= 1;
+            if (!_LoadScanlineLinear(vrow0, width, pSrc2, bRowPitch, srcb.format, filter))
+                return E_FAIL;
+            pSrc2 += bRowPitch;
 
-            if (width > 1)
-                width >>= 1;
+            if (vrow0 != vrow1)
+            {
+                if (!_LoadScanlineLinear(vrow1, width, pSrc2, bRowPitch, srcb.format, filter))
+                    return E_FAIL;
+                pSrc2 += bRowPitch;
+            }
 
-            if (depth > 1)
-                depth >>= 1;
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                size_t x2 = x << 1;
+
+                AVERAGE8(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2],
+                    vrow0[x2], vrow1[x2], vrow2[x2], vrow3[x2])
+            }
+
+            if (!_StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
         }
 
         return S_OK;
@@ -1774,7 +2610,7 @@ namespace
 
 
     //--- 3D Box Filter ---
-    HRESULT Generate3DMipsBoxFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsBoxFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t scratchBudget) noexcept
     {
         if (!depth || !mipChain.GetImages())
             return E_INVALIDARG;
@@ -1789,8 +2625,15 @@ namespace
         if (!ispow2(width) || !ispow2(height) || !ispow2(depth))
             return E_FAIL;
 
-        // Allocate temporary space (5 scanlines)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 5), 16)));
+        const size_t stride = width * 5;
+
+        size_t threads = 0;
+        HRESULT hr = Mip3DThreadCount(sizeof(XMVECTOR) * stride, 0, scratchBudget, threads);
+        if (FAILED(hr))
+            return hr;
+
+        // Allocate temporary space (5 scanlines per thread)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
 
@@ -1798,13 +2641,9 @@ namespace
 
         XMVECTOR* urow0 = target + width;
         XMVECTOR* urow1 = target + width * 2;
-        XMVECTOR* vrow0 = target + width * 3;
-        XMVECTOR* vrow1 = target + width * 4;
 
         const XMVECTOR* urow2 = urow0 + 1;
         const XMVECTOR* urow3 = urow1 + 1;
-        const XMVECTOR* vrow2 = vrow0 + 1;
-        const XMVECTOR* vrow3 = vrow1 + 1;
 
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
@@ -1812,15 +2651,13 @@ namespace
             if (height <= 1)
             {
                 urow1 = urow0;
-                vrow1 = vrow0;
+                urow3 = urow1 + 1;
             }
 
             if (width <= 1)
             {
                 urow2 = urow0;
                 urow3 = urow1;
-                vrow2 = vrow0;
-                vrow3 = vrow1;
             }
 
             if (depth > 1)
@@ -1828,65 +2665,32 @@ namespace
                 // 3D box filter
                 size_t ndepth = depth >> 1;
 
-                for (size_t slice = 0; slice < ndepth; ++slice)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(threads)) if (threads > 1) schedule(static)
+#endif
+                for (int slice = 0; slice < static_cast<int>(ndepth); ++slice)
                 {
-                    size_t slicea = std::min<size_t>(slice * 2, depth - 1);
+                    size_t slicea = std::min<size_t>(size_t(slice) * 2, depth - 1);
                     size_t sliceb = std::min<size_t>(slicea + 1, depth - 1);
 
                     const Image* srca = mipChain.GetImage(level - 1, 0, slicea);
                     const Image* srcb = mipChain.GetImage(level - 1, 0, sliceb);
-                    const Image* dest = mipChain.GetImage(level, 0, slice);
+                    const Image* dest = mipChain.GetImage(level, 0, size_t(slice));
 
-                    if (!srca || !srcb || !dest)
-                        return E_POINTER;
-
-                    const uint8_t* pSrc1 = srca->pixels;
-                    const uint8_t* pSrc2 = srcb->pixels;
-                    uint8_t* pDest = dest->pixels;
-
-                    size_t aRowPitch = srca->rowPitch;
-                    size_t bRowPitch = srcb->rowPitch;
-
-                    size_t nwidth = (width > 1) ? (width >> 1) : 1;
-                    size_t nheight = (height > 1) ? (height >> 1) : 1;
-
-                    for (size_t y = 0; y < nheight; ++y)
+                    HRESULT hrSlice = (srca && srcb && dest)
+                        ? BoxFilterSlice(*srca, *srcb, *dest, width, height, filter, scanline.get() + stride * MipThreadIndex())
+                        : E_POINTER;
+                    if (FAILED(hrSlice))
                     {
-                        if (!_LoadScanlineLinear(urow0, width, pSrc1, aRowPitch, srca->format, filter))
-                            return E_FAIL;
-                        pSrc1 += aRowPitch;
-
-                        if (urow0 != urow1)
-                        {
-                            if (!_LoadScanlineLinear(urow1, width, pSrc1, aRowPitch, srca->format, filter))
-                                return E_FAIL;
-                            pSrc1 += aRowPitch;
-                        }
-
-                        if (!_LoadScanlineLinear(vrow0, width, pSrc2, bRowPitch, srcb->format, filter))
-                            return E_FAIL;
-                        pSrc2 += bRowPitch;
-
-                        if (vrow0 != vrow1)
-                        {
-                            if (!_LoadScanlineLinear(vrow1, width, pSrc2, bRowPitch, srcb->format, filter))
-                                return E_FAIL;
-                            pSrc2 += bRowPitch;
-                        }
-
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            size_t x2 = x << 1;
-
-                            AVERAGE8(target[x], urow0[x2], urow1[x2], urow2[x2], urow3[x2],
-                                vrow0[x2], vrow1[x2], vrow2[x2], vrow3[x2])
-                        }
-
-                        if (!_StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        hr = hrSlice;
                     }
                 }
+
+                if (FAILED(hr))
+                    return hr;
             }
             else
             {
@@ -1945,8 +2749,90 @@ namespace
     }
 
 
+    //--- 3D linear filter for one destination slice ---
+    HRESULT LinearFilterSlice(
+        const Image& srca,
+        const Image& srcb,
+        const Image& dest,
+        const LinearFilter& toZ,
+        _In_reads_(nwidth) const LinearFilter* lfX,
+        _In_reads_(nheight) const LinearFilter* lfY,
+        size_t width,
+        size_t nwidth,
+        size_t nheight,
+        TEX_FILTER_FLAGS filter,
+        _Inout_ XMVECTOR* scratch) noexcept
+    {
+        XMVECTOR* target = scratch;
+
+        XMVECTOR* urow0 = scratch + width;
+        XMVECTOR* urow1 = scratch + width * 2;
+        XMVECTOR* vrow0 = scratch + width * 3;
+        XMVECTOR* vrow1 = scratch + width * 4;
+
+#ifdef _DEBUG
+        memset(urow0, 0xCD, sizeof(XMVECTOR)*width);
+        memset(urow1, 0xDD, sizeof(XMVECTOR)*width);
+        memset(vrow0, 0xED, sizeof(XMVECTOR)*width);
+        memset(vrow1, 0xFD, sizeof(XMVECTOR)*width);
+#endif
+
+        size_t u0 = size_t(-1);
+        size_t u1 = size_t(-1);
+
+        uint8_t* pDest = dest.pixels;
+
+        for (size_t y = 0; y < nheight; ++y)
+        {
+            auto& toY = lfY[y];
+
+            if (toY.u0 != u0)
+            {
+                if (toY.u0 != u1)
+                {
+                    u0 = toY.u0;
+
+                    if (!_LoadScanlineLinear(urow0, width, srca.pixels + (srca.rowPitch * u0), srca.rowPitch, srca.format, filter)
+                        || !_LoadScanlineLinear(vrow0, width, srcb.pixels + (srcb.rowPitch * u0), srcb.rowPitch, srcb.format, filter))
+                        return E_FAIL;
+                }
+                else
+                {
+                    u0 = u1;
+                    u1 = size_t(-1);
+
+                    std::swap(urow0, urow1);
+                    std::swap(vrow0, vrow1);
+                }
+            }
+
+            if (toY.u1 != u1)
+            {
+                u1 = toY.u1;
+
+                if (!_LoadScanlineLinear(urow1, width, srca.pixels + (srca.rowPitch * u1), srca.rowPitch, srca.format, filter)
+                    || !_LoadScanlineLinear(vrow1, width, srcb.pixels + (srcb.rowPitch * u1), srcb.rowPitch, srcb.format, filter))
+                    return E_FAIL;
+            }
+
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                auto& toX = lfX[x];
+
+                TRILINEAR_INTERPOLATE(target[x], toX, toY, toZ, urow0, urow1, vrow0, vrow1)
+            }
+
+            if (!_StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
+        }
+
+        return S_OK;
+    }
+
+
     //--- 3D Linear Filter ---
-    HRESULT Generate3DMipsLinearFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsLinearFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t scratchBudget) noexcept
     {
         if (!depth || !mipChain.GetImages())
             return E_INVALIDARG;
@@ -1958,8 +2844,15 @@ namespace
         size_t width = mipChain.GetMetadata().width;
         size_t height = mipChain.GetMetadata().height;
 
-        // Allocate temporary space (5 scanlines, plus X/Y/Z filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 5), 16)));
+        const size_t stride = width * 5;
+
+        size_t threads = 0;
+        HRESULT hr = Mip3DThreadCount(sizeof(XMVECTOR) * stride, sizeof(LinearFilter) * (width + height + depth), scratchBudget, threads);
+        if (FAILED(hr))
+            return hr;
+
+        // Allocate temporary space (5 scanlines per thread, plus X/Y/Z filters)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
 
@@ -1975,8 +2868,6 @@ namespace
 
         XMVECTOR* urow0 = target + width;
         XMVECTOR* urow1 = target + width * 2;
-        XMVECTOR* vrow0 = target + width * 3;
-        XMVECTOR* vrow1 = target + width * 4;
 
         // Resize base image to each target mip level
         for (size_t level = 1; level < levels; ++level)
@@ -1990,8 +2881,6 @@ namespace
 #ifdef _DEBUG
             memset(urow0, 0xCD, sizeof(XMVECTOR)*width);
             memset(urow1, 0xDD, sizeof(XMVECTOR)*width);
-            memset(vrow0, 0xED, sizeof(XMVECTOR)*width);
-            memset(vrow1, 0xFD, sizeof(XMVECTOR)*width);
 #endif
 
             if (depth > 1)
@@ -2000,69 +2889,31 @@ namespace
                 size_t ndepth = depth >> 1;
                 _CreateLinearFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, lfZ);
 
-                for (size_t slice = 0; slice < ndepth; ++slice)
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(threads)) if (threads > 1) schedule(static)
+#endif
+                for (int slice = 0; slice < static_cast<int>(ndepth); ++slice)
                 {
                     auto& toZ = lfZ[slice];
 
                     const Image* srca = mipChain.GetImage(level - 1, 0, toZ.u0);
                     const Image* srcb = mipChain.GetImage(level - 1, 0, toZ.u1);
-                    if (!srca || !srcb)
-                        return E_POINTER;
-
-                    size_t u0 = size_t(-1);
-                    size_t u1 = size_t(-1);
-
-                    const Image* dest = mipChain.GetImage(level, 0, slice);
-                    if (!dest)
-                        return E_POINTER;
-
-                    uint8_t* pDest = dest->pixels;
+                    const Image* dest = mipChain.GetImage(level, 0, size_t(slice));
 
-                    for (size_t y = 0; y < nheight; ++y)
+                    HRESULT hrSlice = (srca && srcb && dest)
+                        ? LinearFilterSlice(*srca, *srcb, *dest, toZ, lfX, lfY, width, nwidth, nheight, filter, scanline.get() + stride * MipThreadIndex())
+                        : E_POINTER;
+                    if (FAILED(hrSlice))
                     {
-                        auto& toY = lfY[y];
-
-                        if (toY.u0 != u0)
-                        {
-                            if (toY.u0 != u1)
-                            {
-                                u0 = toY.u0;
-
-                                if (!_LoadScanlineLinear(urow0, width, srca->pixels + (srca->rowPitch * u0), srca->rowPitch, srca->format, filter)
-                                    || !_LoadScanlineLinear(vrow0, width, srcb->pixels + (srcb->rowPitch * u0), srcb->rowPitch, srcb->format, filter))
-                                    return E_FAIL;
-                            }
-                            else
-                            {
-                                u0 = u1;
-                                u1 = size_t(-1);
-
-                                std::swap(urow0, urow1);
-                                std::swap(vrow0, vrow1);
-                            }
-                        }
-
-                        if (toY.u1 != u1)
-                        {
-                            u1 = toY.u1;
-
-                            if (!_LoadScanlineLinear(urow1, width, srca->pixels + (srca->rowPitch * u1), srca->rowPitch, srca->format, filter)
-                                || !_LoadScanlineLinear(vrow1, width, srcb->pixels + (srcb->rowPitch * u1), srcb->rowPitch, srcb->format, filter))
-                                return E_FAIL;
-                        }
-
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            auto& toX = lfX[x];
-
-                            TRILINEAR_INTERPOLATE(target[x], toX, toY, toZ, urow0, urow1, vrow0, vrow1)
-                        }
-
-                        if (!_StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        hr = hrSlice;
                     }
                 }
+
+                if (FAILED(hr))
+                    return hr;
             }
             else
             {
@@ -2138,40 +2989,30 @@ namespace
     }
 
 
-    //--- 3D Cubic Filter ---
-    HRESULT Generate3DMipsCubicFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    //--- 3D cubic filter for one destination slice ---
+    HRESULT CubicFilterSlice(
+        const Image& srca,
+        const Image& srcb,
+        const Image& srcc,
+        const Image& srcd,
+        const Image& dest,
+        const CubicFilter& toZ,
+        _In_reads_(nwidth) const CubicFilter* cfX,
+        _In_reads_(nheight) const CubicFilter* cfY,
+        size_t width,
+        size_t nwidth,
+        size_t nheight,
+        TEX_FILTER_FLAGS filter,
+        _Inout_ XMVECTOR* scratch) noexcept
     {
-        if (!depth || !mipChain.GetImages())
-            return E_INVALIDARG;
-
-        // This assumes that the base images are already placed into the mipChain at the top level... (see _Setup3DMips)
-
-        assert(levels > 1);
-
-        size_t width = mipChain.GetMetadata().width;
-        size_t height = mipChain.GetMetadata().height;
-
-        // Allocate temporary space (17 scanlines, plus X/Y/Z filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc((sizeof(XMVECTOR)*width * 17), 16)));
-        if (!scanline)
-            return E_OUTOFMEMORY;
-
-        std::unique_ptr<CubicFilter[]> cf(new (std::nothrow) CubicFilter[width + height + depth]);
-        if (!cf)
-            return E_OUTOFMEMORY;
-
-        CubicFilter* cfX = cf.get();
-        CubicFilter* cfY = cf.get() + width;
-        CubicFilter* cfZ = cf.get() + width + height;
-
-        XMVECTOR* target = scanline.get();
+        XMVECTOR* target = scratch;
 
         XMVECTOR* urow[4];
         XMVECTOR* vrow[4];
         XMVECTOR* srow[4];
         XMVECTOR* trow[4];
 
-        XMVECTOR *ptr = scanline.get() + width;
+        XMVECTOR *ptr = scratch + width;
         for (size_t j = 0; j < 4; ++j)
         {
             urow[j] = ptr;  ptr += width;
@@ -2180,199 +3021,274 @@ namespace
             trow[j] = ptr;  ptr += width;
         }
 
-        // Resize base image to each target mip level
-        for (size_t level = 1; level < levels; ++level)
+#ifdef _DEBUG
+        for (size_t j = 0; j < 4; ++j)
         {
-            size_t nwidth = (width > 1) ? (width >> 1) : 1;
-            _CreateCubicFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, cfX);
+            memset(urow[j], 0xCD, sizeof(XMVECTOR)*width);
+            memset(vrow[j], 0xDD, sizeof(XMVECTOR)*width);
+            memset(srow[j], 0xED, sizeof(XMVECTOR)*width);
+            memset(trow[j], 0xFD, sizeof(XMVECTOR)*width);
+        }
+#endif
 
-            size_t nheight = (height > 1) ? (height >> 1) : 1;
-            _CreateCubicFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
+        size_t u0 = size_t(-1);
+        size_t u1 = size_t(-1);
+        size_t u2 = size_t(-1);
+        size_t u3 = size_t(-1);
 
-#ifdef _DEBUG
-            for (size_t j = 0; j < 4; ++j)
+        uint8_t* pDest = dest.pixels;
+
+        for (size_t y = 0; y < nheight; ++y)
+        {
+            auto& toY = cfY[y];
+
+            // Scanline 1
+            if (toY.u0 != u0)
             {
-                memset(urow[j], 0xCD, sizeof(XMVECTOR)*width);
-                memset(vrow[j], 0xDD, sizeof(XMVECTOR)*width);
-                memset(srow[j], 0xED, sizeof(XMVECTOR)*width);
-                memset(trow[j], 0xFD, sizeof(XMVECTOR)*width);
+                if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
+                {
+                    u0 = toY.u0;
+
+                    if (!_LoadScanlineLinear(urow[0], width, srca.pixels + (srca.rowPitch * u0), srca.rowPitch, srca.format, filter)
+                        || !_LoadScanlineLinear(urow[1], width, srcb.pixels + (srcb.rowPitch * u0), srcb.rowPitch, srcb.format, filter)
+                        || !_LoadScanlineLinear(urow[2], width, srcc.pixels + (srcc.rowPitch * u0), srcc.rowPitch, srcc.format, filter)
+                        || !_LoadScanlineLinear(urow[3], width, srcd.pixels + (srcd.rowPitch * u0), srcd.rowPitch, srcd.format, filter))
+                        return E_FAIL;
+                }
+                else if (toY.u0 == u1)
+                {
+                    u0 = u1;
+                    u1 = size_t(-1);
+
+                    std::swap(urow[0], vrow[0]);
+                    std::swap(urow[1], vrow[1]);
+                    std::swap(urow[2], vrow[2]);
+                    std::swap(urow[3], vrow[3]);
+                }
+                else if (toY.u0 == u2)
+                {
+                    u0 = u2;
+                    u2 = size_t(-1);
+
+                    std::swap(urow[0], srow[0]);
+                    std::swap(urow[1], srow[1]);
+                    std::swap(urow[2], srow[2]);
+                    std::swap(urow[3], srow[3]);
+                }
+                else if (toY.u0 == u3)
+                {
+                    u0 = u3;
+                    u3 = size_t(-1);
+
+                    std::swap(urow[0], trow[0]);
+                    std::swap(urow[1], trow[1]);
+                    std::swap(urow[2], trow[2]);
+                    std::swap(urow[3], trow[3]);
+                }
             }
-#endif
 
-            if (depth > 1)
+            // Scanline 2
+            if (toY.u1 != u1)
             {
-                // 3D cubic filter
-                size_t ndepth = depth >> 1;
-                _CreateCubicFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, (filter & TEX_FILTER_MIRROR_W) != 0, cfZ);
+                if (toY.u1 != u2 && toY.u1 != u3)
+                {
+                    u1 = toY.u1;
 
-                for (size_t slice = 0; slice < ndepth; ++slice)
+                    if (!_LoadScanlineLinear(vrow[0], width, srca.pixels + (srca.rowPitch * u1), srca.rowPitch, srca.format, filter)
+                        || !_LoadScanlineLinear(vrow[1], width, srcb.pixels + (srcb.rowPitch * u1), srcb.rowPitch, srcb.format, filter)
+                        || !_LoadScanlineLinear(vrow[2], width, srcc.pixels + (srcc.rowPitch * u1), srcc.rowPitch, srcc.format, filter)
+                        || !_LoadScanlineLinear(vrow[3], width, srcd.pixels + (srcd.rowPitch * u1), srcd.rowPitch, srcd.format, filter))
+                        return E_FAIL;
+                }
+                else if (toY.u1 == u2)
                 {
-                    auto& toZ = cfZ[slice];
+                    u1 = u2;
+                    u2 = size_t(-1);
 
-                    const Image* srca = mipChain.GetImage(level - 1, 0, toZ.u0);
-                    const Image* srcb = mipChain.GetImage(level - 1, 0, toZ.u1);
-                    const Image* srcc = mipChain.GetImage(level - 1, 0, toZ.u2);
-                    const Image* srcd = mipChain.GetImage(level - 1, 0, toZ.u3);
-                    if (!srca || !srcb || !srcc || !srcd)
-                        return E_POINTER;
+                    std::swap(vrow[0], srow[0]);
+                    std::swap(vrow[1], srow[1]);
+                    std::swap(vrow[2], srow[2]);
+                    std::swap(vrow[3], srow[3]);
+                }
+                else if (toY.u1 == u3)
+                {
+                    u1 = u3;
+                    u3 = size_t(-1);
 
-                    size_t u0 = size_t(-1);
-                    size_t u1 = size_t(-1);
-                    size_t u2 = size_t(-1);
-                    size_t u3 = size_t(-1);
+                    std::swap(vrow[0], trow[0]);
+                    std::swap(vrow[1], trow[1]);
+                    std::swap(vrow[2], trow[2]);
+                    std::swap(vrow[3], trow[3]);
+                }
+            }
 
-                    const Image* dest = mipChain.GetImage(level, 0, slice);
-                    if (!dest)
-                        return E_POINTER;
+            // Scanline 3
+            if (toY.u2 != u2)
+            {
+                if (toY.u2 != u3)
+                {
+                    u2 = toY.u2;
 
-                    uint8_t* pDest = dest->pixels;
+                    if (!_LoadScanlineLinear(srow[0], width, srca.pixels + (srca.rowPitch * u2), srca.rowPitch, srca.format, filter)
+                        || !_LoadScanlineLinear(srow[1], width, srcb.pixels + (srcb.rowPitch * u2), srcb.rowPitch, srcb.format, filter)
+                        || !_LoadScanlineLinear(srow[2], width, srcc.pixels + (srcc.rowPitch * u2), srcc.rowPitch, srcc.format, filter)
+                        || !_LoadScanlineLinear(srow[3], width, srcd.pixels + (srcd.rowPitch * u2), srcd.rowPitch, srcd.format, filter))
+                        return E_FAIL;
+                }
+                else
+                {
+                    u2 = u3;
+                    u3 = size_t(-1);
 
-                    for (size_t y = 0; y < nheight; ++y)
-                    {
-                        auto& toY = cfY[y];
+                    std::swap(srow[0], trow[0]);
+                    std::swap(srow[1], trow[1]);
+                    std::swap(srow[2], trow[2]);
+                    std::swap(srow[3], trow[3]);
+                }
+            }
 
-                        // Scanline 1
-                        if (toY.u0 != u0)
-                        {
-                            if (toY.u0 != u1 && toY.u0 != u2 && toY.u0 != u3)
-                            {
-                                u0 = toY.u0;
+            // Scanline 4
+            if (toY.u3 != u3)
+            {
+                u3 = toY.u3;
 
-                                if (!_LoadScanlineLinear(urow[0], width, srca->pixels + (srca->rowPitch * u0), srca->rowPitch, srca->format, filter)
-                                    || !_LoadScanlineLinear(urow[1], width, srcb->pixels + (srcb->rowPitch * u0), srcb->rowPitch, srcb->format, filter)
-                                    || !_LoadScanlineLinear(urow[2], width, srcc->pixels + (srcc->rowPitch * u0), srcc->rowPitch, srcc->format, filter)
-                                    || !_LoadScanlineLinear(urow[3], width, srcd->pixels + (srcd->rowPitch * u0), srcd->rowPitch, srcd->format, filter))
-                                    return E_FAIL;
-                            }
-                            else if (toY.u0 == u1)
-                            {
-                                u0 = u1;
-                                u1 = size_t(-1);
+                if (!_LoadScanlineLinear(trow[0], width, srca.pixels + (srca.rowPitch * u3), srca.rowPitch, srca.format, filter)
+                    || !_LoadScanlineLinear(trow[1], width, srcb.pixels + (srcb.rowPitch * u3), srcb.rowPitch, srcb.format, filter)
+                    || !_LoadScanlineLinear(trow[2], width, srcc.pixels + (srcc.rowPitch * u3), srcc.rowPitch, srcc.format, filter)
+                    || !_LoadScanlineLinear(trow[3], width, srcd.pixels + (srcd.rowPitch * u3), srcd.rowPitch, srcd.format, filter))
+                    return E_FAIL;
+            }
 
-                                std::swap(urow[0], vrow[0]);
-                                std::swap(urow[1], vrow[1]);
-                                std::swap(urow[2], vrow[2]);
-                                std::swap(urow[3], vrow[3]);
-                            }
-                            else if (toY.u0 == u2)
-                            {
-                                u0 = u2;
-                                u2 = size_t(-1);
+            for (size_t x = 0; x < nwidth; ++x)
+            {
+                auto& toX = cfX[x];
 
-                                std::swap(urow[0], srow[0]);
-                                std::swap(urow[1], srow[1]);
-                                std::swap(urow[2], srow[2]);
-                                std::swap(urow[3], srow[3]);
-                            }
-                            else if (toY.u0 == u3)
-                            {
-                                u0 = u3;
-                                u3 = size_t(-1);
+                XMVECTOR D[4];
 
-                                std::swap(urow[0], trow[0]);
-                                std::swap(urow[1], trow[1]);
-                                std::swap(urow[2], trow[2]);
-                                std::swap(urow[3], trow[3]);
-                            }
-                        }
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    XMVECTOR C0, C1, C2, C3;
+                    CUBIC_INTERPOLATE(C0, toX.x, urow[j][toX.u0], urow[j][toX.u1], urow[j][toX.u2], urow[j][toX.u3])
+                    CUBIC_INTERPOLATE(C1, toX.x, vrow[j][toX.u0], vrow[j][toX.u1], vrow[j][toX.u2], vrow[j][toX.u3])
+                    CUBIC_INTERPOLATE(C2, toX.x, srow[j][toX.u0], srow[j][toX.u1], srow[j][toX.u2], srow[j][toX.u3])
+                    CUBIC_INTERPOLATE(C3, toX.x, trow[j][toX.u0], trow[j][toX.u1], trow[j][toX.u2], trow[j][toX.u3])
 
-                        // Scanline 2
-                        if (toY.u1 != u1)
-                        {
-                            if (toY.u1 != u2 && toY.u1 != u3)
-                            {
-                                u1 = toY.u1;
+                    CUBIC_INTERPOLATE(D[j], toY.x, C0, C1, C2, C3)
+                }
 
-                                if (!_LoadScanlineLinear(vrow[0], width, srca->pixels + (srca->rowPitch * u1), srca->rowPitch, srca->format, filter)
-                                    || !_LoadScanlineLinear(vrow[1], width, srcb->pixels + (srcb->rowPitch * u1), srcb->rowPitch, srcb->format, filter)
-                                    || !_LoadScanlineLinear(vrow[2], width, srcc->pixels + (srcc->rowPitch * u1), srcc->rowPitch, srcc->format, filter)
-                                    || !_LoadScanlineLinear(vrow[3], width, srcd->pixels + (srcd->rowPitch * u1), srcd->rowPitch, srcd->format, filter))
-                                    return E_FAIL;
-                            }
-                            else if (toY.u1 == u2)
-                            {
-                                u1 = u2;
-                                u2 = size_t(-1);
+                CUBIC_INTERPOLATE(target[x], toZ.x, D[0], D[1], D[2], D[3])
+            }
 
-                                std::swap(vrow[0], srow[0]);
-                                std::swap(vrow[1], srow[1]);
-                                std::swap(vrow[2], srow[2]);
-                                std::swap(vrow[3], srow[3]);
-                            }
-                            else if (toY.u1 == u3)
-                            {
-                                u1 = u3;
-                                u3 = size_t(-1);
+            if (!_StoreScanlineLinear(pDest, dest.rowPitch, dest.format, target, nwidth, filter))
+                return E_FAIL;
+            pDest += dest.rowPitch;
+        }
 
-                                std::swap(vrow[0], trow[0]);
-                                std::swap(vrow[1], trow[1]);
-                                std::swap(vrow[2], trow[2]);
-                                std::swap(vrow[3], trow[3]);
-                            }
-                        }
+        return S_OK;
+    }
 
-                        // Scanline 3
-                        if (toY.u2 != u2)
-                        {
-                            if (toY.u2 != u3)
-                            {
-                                u2 = toY.u2;
 
-                                if (!_LoadScanlineLinear(srow[0], width, srca->pixels + (srca->rowPitch * u2), srca->rowPitch, srca->format, filter)
-                                    || !_LoadScanlineLinear(srow[1], width, srcb->pixels + (srcb->rowPitch * u2), srcb->rowPitch, srcb->format, filter)
-                                    || !_LoadScanlineLinear(srow[2], width, srcc->pixels + (srcc->rowPitch * u2), srcc->rowPitch, srcc->format, filter)
-                                    || !_LoadScanlineLinear(srow[3], width, srcd->pixels + (srcd->rowPitch * u2), srcd->rowPitch, srcd->format, filter))
-                                    return E_FAIL;
-                            }
-                            else
-                            {
-                                u2 = u3;
-                                u3 = size_t(-1);
+    //--- 3D Cubic Filter ---
+    HRESULT Generate3DMipsCubicFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t scratchBudget) noexcept
+    {
+        if (!depth || !mipChain.GetImages())
+            return E_INVALIDARG;
 
-                                std::swap(srow[0], trow[0]);
-                                std::swap(srow[1], trow[1]);
-                                std::swap(srow[2], trow[2]);
-                                std::swap(srow[3], trow[3]);
-                            }
-                        }
+        // This assumes that the base images are already placed into the mipChain at the top level... (see _Setup3DMips)
 
-                        // Scanline 4
-                        if (toY.u3 != u3)
-                        {
-                            u3 = toY.u3;
+        assert(levels > 1);
+
+        size_t width = mipChain.GetMetadata().width;
+        size_t height = mipChain.GetMetadata().height;
+
+        const size_t stride = width * 17;
+
+        size_t threads = 0;
+        HRESULT hr = Mip3DThreadCount(sizeof(XMVECTOR) * stride, sizeof(CubicFilter) * (width + height + depth), scratchBudget, threads);
+        if (FAILED(hr))
+            return hr;
+
+        // Allocate temporary space (17 scanlines per thread, plus X/Y/Z filters)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
+        if (!scanline)
+            return E_OUTOFMEMORY;
+
+        std::unique_ptr<CubicFilter[]> cf(new (std::nothrow) CubicFilter[width + height + depth]);
+        if (!cf)
+            return E_OUTOFMEMORY;
+
+        CubicFilter* cfX = cf.get();
+        CubicFilter* cfY = cf.get() + width;
+        CubicFilter* cfZ = cf.get() + width + height;
+
+        XMVECTOR* target = scanline.get();
+
+        XMVECTOR* urow[4];
+        XMVECTOR* vrow[4];
+        XMVECTOR* srow[4];
+        XMVECTOR* trow[4];
+
+        XMVECTOR *ptr = scanline.get() + width;
+        for (size_t j = 0; j < 4; ++j)
+        {
+            urow[j] = ptr;  ptr += width;
+            vrow[j] = ptr;  ptr += width;
+            srow[j] = ptr;  ptr += width;
+            trow[j] = ptr;  ptr += width;
+        }
 
-                            if (!_LoadScanlineLinear(trow[0], width, srca->pixels + (srca->rowPitch * u3), srca->rowPitch, srca->format, filter)
-                                || !_LoadScanlineLinear(trow[1], width, srcb->pixels + (srcb->rowPitch * u3), srcb->rowPitch, srcb->format, filter)
-                                || !_LoadScanlineLinear(trow[2], width, srcc->pixels + (srcc->rowPitch * u3), srcc->rowPitch, srcc->format, filter)
-                                || !_LoadScanlineLinear(trow[3], width, srcd->pixels + (srcd->rowPitch * u3), srcd->rowPitch, srcd->format, filter))
-                                return E_FAIL;
-                        }
+        // Resize base image to each target mip level
+        for (size_t level = 1; level < levels; ++level)
+        {
+            size_t nwidth = (width > 1) ? (width >> 1) : 1;
+            _CreateCubicFilter(width, nwidth, (filter & TEX_FILTER_WRAP_U) != 0, (filter & TEX_FILTER_MIRROR_U) != 0, cfX);
 
-                        for (size_t x = 0; x < nwidth; ++x)
-                        {
-                            auto& toX = cfX[x];
+            size_t nheight = (height > 1) ? (height >> 1) : 1;
+            _CreateCubicFilter(height, nheight, (filter & TEX_FILTER_WRAP_V) != 0, (filter & TEX_FILTER_MIRROR_V) != 0, cfY);
 
-                            XMVECTOR D[4];
+#ifdef _DEBUG
+            for (size_t j = 0; j < 4; ++j)
+            {
+                memset(urow[j], 0xCD, sizeof(XMVECTOR)*width);
+                memset(vrow[j], 0xDD, sizeof(XMVECTOR)*width);
+                memset(srow[j], 0xED, sizeof(XMVECTOR)*width);
+                memset(trow[j], 0xFD, sizeof(XMVECTOR)*width);
+            }
+#endif
 
-                            for (size_t j = 0; j < 4; ++j)
-                            {
-                                XMVECTOR C0, C1, C2, C3;
-                                CUBIC_INTERPOLATE(C0, toX.x, urow[j][toX.u0], urow[j][toX.u1], urow[j][toX.u2], urow[j][toX.u3])
-                                CUBIC_INTERPOLATE(C1, toX.x, vrow[j][toX.u0], vrow[j][toX.u1], vrow[j][toX.u2], vrow[j][toX.u3])
-                                CUBIC_INTERPOLATE(C2, toX.x, srow[j][toX.u0], srow[j][toX.u1], srow[j][toX.u2], srow[j][toX.u3])
-                                CUBIC_INTERPOLATE(C3, toX.x, trow[j][toX.u0], trow[j][toX.u1], trow[j][toX.u2], trow[j][toX.u3])
+            if (depth > 1)
+            {
+                // 3D cubic filter
+                size_t ndepth = depth >> 1;
+                _CreateCubicFilter(depth, ndepth, (filter & TEX_FILTER_WRAP_W) != 0, (filter & TEX_FILTER_MIRROR_W) != 0, cfZ);
 
-                                CUBIC_INTERPOLATE(D[j], toY.x, C0, C1, C2, C3)
-                            }
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(static_cast<int>(threads)) if (threads > 1) schedule(static)
+#endif
+                for (int slice = 0; slice < static_cast<int>(ndepth); ++slice)
+                {
+                    auto& toZ = cfZ[slice];
 
-                            CUBIC_INTERPOLATE(target[x], toZ.x, D[0], D[1], D[2], D[3])
-                        }
+                    const Image* srca = mipChain.GetImage(level - 1, 0, toZ.u0);
+                    const Image* srcb = mipChain.GetImage(level - 1, 0, toZ.u1);
+                    const Image* srcc = mipChain.GetImage(level - 1, 0, toZ.u2);
+                    const Image* srcd = mipChain.GetImage(level - 1, 0, toZ.u3);
+                    const Image* dest = mipChain.GetImage(level, 0, size_t(slice));
 
-                        if (!_StoreScanlineLinear(pDest, dest->rowPitch, dest->format, target, nwidth, filter))
-                            return E_FAIL;
-                        pDest += dest->rowPitch;
+                    HRESULT hrSlice = (srca && srcb && srcc && srcd && dest)
+                        ? CubicFilterSlice(*srca, *srcb, *srcc, *srcd, *dest, toZ, cfX, cfY, width, nwidth, nheight, filter, scanline.get() + stride * MipThreadIndex())
+                        : E_POINTER;
+                    if (FAILED(hrSlice))
+                    {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                        hr = hrSlice;
                     }
                 }
+
+                if (FAILED(hr))
+                    return hr;
             }
             else
             {
@@ -2518,7 +3434,7 @@ namespace
 
 
     //--- 3D Triangle Filter ---
-    HRESULT Generate3DMipsTriangleFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain) noexcept
+    HRESULT Generate3DMipsTriangleFilter(size_t depth, size_t levels, TEX_FILTER_FLAGS filter, const ScratchImage& mipChain, size_t scratchBudget) noexcept
     {
         if (!depth || !mipChain.GetImages())
             return E_INVALIDARG;
@@ -2533,7 +3449,7 @@ namespace
         size_t height = mipChain.GetMetadata().height;
 
         // Allocate initial temporary space (1 scanline, accumulation rows, plus X/Y/Z filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * width, 16)));
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc(sizeof(XMVECTOR) * width, 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
 
@@ -2573,6 +3489,52 @@ namespace
             auto yFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfY.get()) + tfY->sizeInBytes);
             auto zFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfZ.get()) + tfZ->sizeInBytes);
 
+            if (scratchBudget && level == 1)
+            {
+                // Accumulation slices are reused by smaller levels, so the first level sets the peak
+                std::unique_ptr<size_t[]> pending(new (std::nothrow) size_t[ndepth]);
+                std::unique_ptr<size_t[]> uses(new (std::nothrow) size_t[ndepth]);
+                if (!pending || !uses)
+                    return E_OUTOFMEMORY;
+
+                memset(uses.get(), 0, sizeof(size_t) * ndepth);
+                for (FilterFrom* zFrom = tfZ->from; zFrom < zFromEnd; )
+                {
+                    for (size_t j = 0; j < zFrom->count; ++j)
+                    {
+                        ++uses[zFrom->to[j].u];
+                    }
+                    zFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(zFrom) + zFrom->sizeInBytes);
+                }
+
+                memset(pending.get(), 0, sizeof(size_t) * ndepth);
+                size_t live = 0;
+                size_t peak = 0;
+                for (FilterFrom* zFrom = tfZ->from; zFrom < zFromEnd; )
+                {
+                    for (size_t j = 0; j < zFrom->count; ++j)
+                    {
+                        if (!pending[zFrom->to[j].u]++)
+                            ++live;
+                    }
+
+                    peak = std::max(peak, live);
+
+                    for (size_t j = 0; j < zFrom->count; ++j)
+                    {
+                        if (pending[zFrom->to[j].u] == uses[zFrom->to[j].u])
+                            --live;
+                    }
+
+                    zFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(zFrom) + zFrom->sizeInBytes);
+                }
+
+                const uint64_t bytes = uint64_t(sizeof(XMVECTOR)) * (uint64_t(width) + uint64_t(peak) * uint64_t(nwidth) * uint64_t(nheight))
+                    + tfX->totalSize + tfY->totalSize + tfZ->totalSize;
+                if (bytes > scratchBudget)
+                    return HRESULT_FROM_WIN32(ERROR_NOT_ENOUGH_MEMORY);
+            }
+
             // Count times slices get written (and clear out any leftover accumulation slices from last miplevel)
             for (FilterFrom* zFrom = tfZ->from; zFrom < zFromEnd; )
             {
@@ -2617,7 +3579,7 @@ namespace
                         else
                         {
                             size_t bytes = sizeof(XMVECTOR) * nwidth * nheight;
-                            sliceAcc->scanline.reset(static_cast<XMVECTOR*>(_aligned_malloc(bytes, 16)));
+                            sliceAcc->scanline.reset(static_cast<XMVECTOR*>(_AlignedAlloc(bytes, 16)));
                             if (!sliceAcc->scanline)
                                 return E_OUTOFMEMORY;
                         }
@@ -2943,11 +3905,14 @@ HRESULT DirectX::GenerateMipMaps(
             return hr;
 
         case TEX_FILTER_TRIANGLE:
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_MITCHELL:
+        case TEX_FILTER_KAISER:
             hr = Setup2DMips(&baseImage, 1, mdata, mipChain);
             if (FAILED(hr))
                 return hr;
 
-            hr = Generate2DMipsTriangleFilter(levels, filter, mipChain, 0);
+            hr = Generate2DMipsSeparable(levels, filter, mipChain, 0);
             if (FAILED(hr))
                 mipChain.Release();
             return hr;
@@ -3116,74 +4081,198 @@ HRESULT DirectX::GenerateMipMaps(
         switch (filter_select)
         {
         case TEX_FILTER_BOX:
-            hr = Setup2DMips(&baseImages[0], metadata.arraySize, mdata2, mipChain);
-            if (FAILED(hr))
-                return hr;
+        case TEX_FILTER_POINT:
+        case TEX_FILTER_LINEAR:
+        case TEX_FILTER_CUBIC:
+        case TEX_FILTER_TRIANGLE:
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_MITCHELL:
+        case TEX_FILTER_KAISER:
+            break;
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsBoxFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
+        default:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+
+        hr = Setup2DMips(&baseImages[0], metadata.arraySize, mdata2, mipChain);
+        if (FAILED(hr))
             return hr;
 
-        case TEX_FILTER_POINT:
-            hr = Setup2DMips(&baseImages[0], metadata.arraySize, mdata2, mipChain);
-            if (FAILED(hr))
-                return hr;
+        // Spread items across threads when there are enough of them to keep every thread busy, when
+        // the images are too small to be split into row bands, or for the separable filters (which have
+        // no row bands); otherwise each item in turn uses row bands.
+#ifdef _OPENMP
+        const bool itemParallel = (metadata.arraySize > 1)
+            && ((metadata.arraySize >= static_cast<size_t>(omp_get_max_threads()))
+                || ((metadata.width * metadata.height) < (MIP_PARALLEL_MIN_PIXELS * 4))
+                || UseSeparableFilter(filter_select));
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
+#pragma omp parallel for if (itemParallel)
+#endif
+        for (int item = 0; item < static_cast<int>(metadata.arraySize); ++item)
+        {
+            HRESULT hrItem = Generate2DMips(filter_select, levels, filter, mipChain, static_cast<size_t>(item));
+            if (FAILED(hrItem))
             {
-                hr = Generate2DMipsPointFilter(levels, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                hr = hrItem;
             }
-            return hr;
+        }
 
-        case TEX_FILTER_LINEAR:
-            hr = Setup2DMips(&baseImages[0], metadata.arraySize, mdata2, mipChain);
-            if (FAILED(hr))
-                return hr;
+        if (FAILED(hr))
+            mipChain.Release();
+        return hr;
+    }
+}
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsLinearFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
-            return hr;
 
-        case TEX_FILTER_CUBIC:
-            hr = Setup2DMips(&baseImages[0], metadata.arraySize, mdata2, mipChain);
-            if (FAILED(hr))
-                return hr;
+//-------------------------------------------------------------------------------------
+// Regenerate the parts of a mipmap chain that depend on changed regions of the top level
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::UpdateMipMaps(
+    const Rect* dirtyRects,
+    size_t nrects,
+    TEX_FILTER_FLAGS filter,
+    size_t item,
+    ScratchImage& mipChain) noexcept
+{
+    if (!dirtyRects || !nrects)
+        return E_INVALIDARG;
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
-            {
-                hr = Generate2DMipsCubicFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
-            }
+    if (!mipChain.GetImages())
+        return E_POINTER;
+
+    const TexMetadata& metadata = mipChain.GetMetadata();
+    if (metadata.IsVolumemap() || item >= metadata.arraySize)
+        return E_INVALIDARG;
+
+    if (metadata.mipLevels <= 1)
+        return S_OK;
+
+    if (IsCompressed(metadata.format) || IsTypeless(metadata.format) || IsPlanar(metadata.format) || IsPalettized(metadata.format))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    // Unquantized intermediate levels aren't kept, so they can't be updated in place
+    if (filter & (TEX_FILTER_FORCE_WIC | TEX_FILTER_FLOAT_MIPS))
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+
+    if ((metadata.width > UINT32_MAX) || (metadata.height > UINT32_MAX))
+        return E_INVALIDARG;
+
+    unsigned long filter_select = (filter & TEX_FILTER_MODE_MASK);
+    if (!filter_select)
+    {
+        // Default filter choice
+        filter_select = (ispow2(metadata.width) && ispow2(metadata.height)) ? TEX_FILTER_BOX : TEX_FILTER_LINEAR;
+    }
+
+    switch (filter_select)
+    {
+    case TEX_FILTER_BOX:
+        if (!ispow2(metadata.width) || !ispow2(metadata.height))
+            return E_FAIL;
+        break;
+
+    case TEX_FILTER_POINT:
+    case TEX_FILTER_LINEAR:
+    case TEX_FILTER_CUBIC:
+        break;
+
+    default:
+        if (!UseSeparableFilter(filter_select))
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        break;
+    }
+
+    for (size_t j = 0; j < nrects; ++j)
+    {
+        const Rect& r = dirtyRects[j];
+        if (!r.w || !r.h
+            || r.x >= metadata.width || r.w > (metadata.width - r.x)
+            || r.y >= metadata.height || r.h > (metadata.height - r.y))
+            return E_INVALIDARG;
+    }
+
+    // Dirty rectangles of the level being read, and of the level being written (up to 4 per rectangle read)
+    std::unique_ptr<Rect[]> rects(new (std::nothrow) Rect[MIP_UPDATE_MAX_RECTS * 8]);
+    if (!rects)
+        return E_OUTOFMEMORY;
+
+    Rect* current = rects.get();
+    Rect* next = current + MIP_UPDATE_MAX_RECTS * 4;
+
+    size_t count = nrects;
+    if (count > MIP_UPDATE_MAX_RECTS)
+    {
+        current[0] = BoundMipUpdateRects(dirtyRects, nrects);
+        count = 1;
+    }
+    else
+    {
+        memcpy(current, dirtyRects, sizeof(Rect) * count);
+    }
+
+    const size_t threads = MipThreadCount();
+    const size_t stride = metadata.width * 5;
+
+    // Allocate temporary space (5 scanlines per thread)
+    ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc((sizeof(XMVECTOR)*stride * threads), 16)));
+    if (!scanline)
+        return E_OUTOFMEMORY;
+
+    MipUpdateLevel lvl = {};
+
+    for (size_t level = 1; level < metadata.mipLevels && count > 0; ++level)
+    {
+        const Image* src = mipChain.GetImage(level - 1, item, 0);
+        const Image* dest = mipChain.GetImage(level, item, 0);
+        if (!src || !dest)
+            return E_POINTER;
+
+        HRESULT hr = SetupMipUpdateLevel(filter_select, filter, src, dest, lvl);
+        if (FAILED(hr))
             return hr;
 
-        case TEX_FILTER_TRIANGLE:
-            hr = Setup2DMips(&baseImages[0], metadata.arraySize, mdata2, mipChain);
-            if (FAILED(hr))
-                return hr;
+        // Expand each dirty rectangle by the filter footprint into this level
+        size_t ncount = 0;
+        for (size_t j = 0; j < count; ++j)
+        {
+            const Rect& r = current[j];
 
-            for (size_t item = 0; item < metadata.arraySize; ++item)
+            size_t xs[2], xe[2], ys[2], ye[2];
+            const size_t nx = FindMipUpdateRuns(lvl.indexX.get(), lvl.tapsX, lvl.nwidth, r.x, r.x + r.w, xs, xe);
+            const size_t ny = FindMipUpdateRuns(lvl.indexY.get(), lvl.tapsY, lvl.nheight, r.y, r.y + r.h, ys, ye);
+
+            for (size_t iy = 0; iy < ny; ++iy)
             {
-                hr = Generate2DMipsTriangleFilter(levels, filter, mipChain, item);
-                if (FAILED(hr))
-                    mipChain.Release();
+                for (size_t ix = 0; ix < nx; ++ix)
+                {
+                    next[ncount++] = Rect(xs[ix], ys[iy], xe[ix] - xs[ix], ye[iy] - ys[iy]);
+                }
             }
-            return hr;
+        }
 
-        default:
-            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        if (ncount > MIP_UPDATE_MAX_RECTS)
+        {
+            next[0] = BoundMipUpdateRects(next, ncount);
+            ncount = 1;
+        }
+
+        for (size_t j = 0; j < ncount; ++j)
+        {
+            hr = UpdateMipRect(lvl, next[j], filter, threads, scanline.get(), stride);
+            if (FAILED(hr))
+                return hr;
         }
+
+        std::swap(current, next);
+        count = ncount;
     }
+
+    return S_OK;
 }
 
 
@@ -3197,6 +4286,18 @@ HRESULT DirectX::GenerateMipMaps3D(
     TEX_FILTER_FLAGS filter,
     size_t levels,
     ScratchImage& mipChain) noexcept
+{
+    return GenerateMipMaps3D(baseImages, depth, filter, levels, 0, mipChain);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateMipMaps3D(
+    const Image* baseImages,
+    size_t depth,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    size_t scratchBudget,
+    ScratchImage& mipChain) noexcept
 {
     if (!baseImages || !depth)
         return E_INVALIDARG;
@@ -3247,7 +4348,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsBoxFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsBoxFilter(depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3257,7 +4358,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsPointFilter(depth, levels, mipChain);
+        hr = Generate3DMipsPointFilter(depth, levels, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3267,7 +4368,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsLinearFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsLinearFilter(depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3277,7 +4378,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsCubicFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsCubicFilter(depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3287,7 +4388,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsTriangleFilter(depth, levels, filter, mipChain);
+        hr = Generate3DMipsTriangleFilter(depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3305,6 +4406,19 @@ HRESULT DirectX::GenerateMipMaps3D(
     TEX_FILTER_FLAGS filter,
     size_t levels,
     ScratchImage& mipChain)
+{
+    return GenerateMipMaps3D(srcImages, nimages, metadata, filter, levels, 0, mipChain);
+}
+
+_Use_decl_annotations_
+HRESULT DirectX::GenerateMipMaps3D(
+    const Image* srcImages,
+    size_t nimages,
+    const TexMetadata& metadata,
+    TEX_FILTER_FLAGS filter,
+    size_t levels,
+    size_t scratchBudget,
+    ScratchImage& mipChain)
 {
     if (!srcImages || !nimages || !IsValid(metadata.format))
         return E_INVALIDARG;
@@ -3363,7 +4477,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsBoxFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsBoxFilter(metadata.depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3373,7 +4487,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsPointFilter(metadata.depth, levels, mipChain);
+        hr = Generate3DMipsPointFilter(metadata.depth, levels, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3383,7 +4497,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsLinearFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsLinearFilter(metadata.depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3393,7 +4507,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsCubicFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsCubicFilter(metadata.depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3403,7 +4517,7 @@ HRESULT DirectX::GenerateMipMaps3D(
         if (FAILED(hr))
             return hr;
 
-        hr = Generate3DMipsTriangleFilter(metadata.depth, levels, filter, mipChain);
+        hr = Generate3DMipsTriangleFilter(metadata.depth, levels, filter, mipChain, scratchBudget);
         if (FAILED(hr))
             mipChain.Release();
         return hr;
@@ -3463,24 +4577,114 @@ HRESULT DirectX::ScaleMipMapsAlphaForCoverage(
         }
     }
 
-    for (size_t level = 1; level < metadata.mipLevels; ++level)
+    if (metadata.mipLevels < 2)
+        return S_OK;
+
+    if (nimages < metadata.mipLevels)
+        return E_FAIL;
+
+    const size_t levels = metadata.mipLevels;
+
+    // Split every level into bands of quad rows, and histogram all of them in one parallel pass
+    size_t bands = 0;
+    for (size_t level = 1; level < levels; ++level)
     {
-        if (level >= nimages)
-            return E_FAIL;
+        const size_t quadRows = (srcImages[level].height > 1) ? (srcImages[level].height - 1) : 0;
+        bands += (quadRows + ALPHA_COVERAGE_BAND_ROWS - 1) / ALPHA_COVERAGE_BAND_ROWS;
+    }
 
-        float alphaScale = 0.0f;
-        hr = EstimateAlphaScaleForCoverage(srcImages[level], alphaReference, targetCoverage, alphaScale);
-        if (FAILED(hr))
-            return hr;
+    std::unique_ptr<uint64_t[]> histograms(new (std::nothrow) uint64_t[levels * ALPHA_COVERAGE_BINS]);
+    std::unique_ptr<size_t[]> bandLevel(new (std::nothrow) size_t[bands + 1]);
+    std::unique_ptr<size_t[]> bandRow(new (std::nothrow) size_t[bands + 1]);
+    if (!histograms || !bandLevel || !bandRow)
+        return E_OUTOFMEMORY;
 
-        const Image* mipImage = mipChain.GetImage(level, item, 0);
-        if (!mipImage)
-            return E_POINTER;
+    memset(histograms.get(), 0, sizeof(uint64_t) * levels * ALPHA_COVERAGE_BINS);
 
-        hr = ScaleAlpha(srcImages[level], alphaScale, *mipImage);
-        if (FAILED(hr))
-            return hr;
+    size_t band = 0;
+    for (size_t level = 1; level < levels; ++level)
+    {
+        const size_t quadRows = (srcImages[level].height > 1) ? (srcImages[level].height - 1) : 0;
+        for (size_t y = 0; y < quadRows; y += ALPHA_COVERAGE_BAND_ROWS)
+        {
+            bandLevel[band] = level;
+            bandRow[band] = y;
+            ++band;
+        }
+    }
+    assert(band == bands);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int j = 0; j < static_cast<int>(bands); ++j)
+    {
+        const size_t level = bandLevel[size_t(j)];
+        const Image& img = srcImages[level];
+        const size_t y0 = bandRow[size_t(j)];
+        const size_t y1 = std::min(y0 + ALPHA_COVERAGE_BAND_ROWS, img.height - 1);
+
+        HRESULT hrBand = E_OUTOFMEMORY;
+        std::unique_ptr<uint32_t[]> local(new (std::nothrow) uint32_t[ALPHA_COVERAGE_BINS]);
+        if (local)
+        {
+            hrBand = (img.width > 1)
+                ? AccumulateAlphaCoverageHistogram(img, alphaReference, y0, y1, local.get())
+                : S_OK;
+        }
+
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            if (FAILED(hrBand))
+            {
+                hr = hrBand;
+            }
+            else if (img.width > 1)
+            {
+                uint64_t* histogram = histograms.get() + level * ALPHA_COVERAGE_BINS;
+                for (size_t k = 0; k < ALPHA_COVERAGE_BINS; ++k)
+                {
+                    histogram[k] += local[k];
+                }
+            }
+        }
+    }
+
+    if (FAILED(hr))
+        return hr;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int level = 1; level < static_cast<int>(levels); ++level)
+    {
+        const Image& img = srcImages[level];
+
+        const uint64_t total = uint64_t((img.width > 1) ? (img.width - 1) : 0) * uint64_t((img.height > 1) ? (img.height - 1) : 0)
+            * ALPHA_COVERAGE_SAMPLES * ALPHA_COVERAGE_SAMPLES;
+
+        const float alphaScale = SolveAlphaScaleForCoverage(histograms.get() + size_t(level) * ALPHA_COVERAGE_BINS, total, targetCoverage);
+
+        HRESULT hrLevel = E_POINTER;
+        const Image* mipImage = mipChain.GetImage(size_t(level), item, 0);
+        if (mipImage)
+        {
+            hrLevel = ScaleAlpha(img, alphaScale, *mipImage);
+        }
+
+        if (FAILED(hrLevel))
+        {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            hr = hrLevel;
+        }
     }
+
+    if (FAILED(hr))
+        return hr;
     
     return S_OK;
 }
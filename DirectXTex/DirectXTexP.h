@@ -320,6 +320,16 @@ namespace DirectX
         _Inout_updates_all_(count) XMVECTOR* pSource, _In_ size_t count, _In_ float threshold, size_t y, size_t z,
         _Inout_updates_all_opt_(count + 2) XMVECTOR* pDiffusionErrors) noexcept;
 
+    // Bytes per pixel when a span of a scanline can be loaded or stored on its own, otherwise 0 (packed or sub-byte formats)
+    inline size_t __cdecl _ScanlineSpanPixelBytes(_In_ DXGI_FORMAT format) noexcept
+    {
+        if (IsCompressed(format) || IsPacked(format) || IsPlanar(format))
+            return 0;
+
+        const size_t bpp = BitsPerPixel(format);
+        return (bpp & 7) ? 0 : (bpp >> 3);
+    }
+
     HRESULT __cdecl _ConvertToR32G32B32A32(_In_ const Image& srcImage, _Inout_ ScratchImage& image) noexcept;
 
     HRESULT __cdecl _ConvertFromR32G32B32A32(_In_ const Image& srcImage, _In_ const Image& destImage) noexcept;
@@ -336,6 +346,31 @@ namespace DirectX
         _Inout_updates_all_(count) XMVECTOR* pBuffer, _In_ size_t count,
         _In_ DXGI_FORMAT outFormat, _In_ DXGI_FORMAT inFormat, _In_ TEX_FILTER_FLAGS flags) noexcept;
 
+    void __cdecl _ConvertHalfToFloatStream(
+        _Out_writes_(count) float* pDestination, _In_reads_(count) const uint16_t* pSource, _In_ size_t count) noexcept;
+
+    void __cdecl _ConvertFloatToHalfStream(
+        _Out_writes_(count) uint16_t* pDestination, _In_reads_(count) const float* pSource, _In_ size_t count) noexcept;
+
+    //---------------------------------------------------------------------------------
+    // Resize helper functions
+    HRESULT __cdecl _ResizeSeparable(
+        _In_ const Image& srcImage, _In_ TEX_FILTER_FLAGS filter, _In_ const Image& destImage,
+        _In_opt_ const Rect* destRect = nullptr) noexcept;
+        // destRect limits the pixels written to that part of destImage
+
+    HRESULT __cdecl _GetResampleTaps(
+        _In_ size_t source, _In_ size_t dest, _In_ TEX_FILTER_FLAGS filter, _In_ bool vertical,
+        _Out_ size_t& taps, _Inout_ std::unique_ptr<uint32_t[]>& index) noexcept;
+        // Source coordinates read by each destination coordinate along one axis (dest * taps entries)
+
+    //---------------------------------------------------------------------------------
+    // Memory helper functions
+    void* __cdecl _AlignedAlloc(_In_ size_t size, _In_ size_t alignment, _In_opt_ IAllocator* allocator = nullptr) noexcept;
+        // Records the allocator ahead of the returned pointer so _AlignedFree can hand the block back to it
+
+    void __cdecl _AlignedFree(_In_opt_ void* ptr) noexcept;
+
     //---------------------------------------------------------------------------------
     // DDS helper functions
     HRESULT __cdecl _EncodeDDSHeader(
@@ -232,7 +232,10 @@ namespace
             break;
 
         case TEX_FILTER_TRIANGLE:
-            // WIC does not implement this filter
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_MITCHELL:
+        case TEX_FILTER_KAISER:
+            // WIC does not implement these filters
             return false;
         }
 
@@ -251,7 +254,7 @@ namespace
         assert(srcImage.format == destImage.format);
 
         // Allocate temporary space (2 scanlines)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc(
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc(
             (sizeof(XMVECTOR) * (srcImage.width + destImage.width)), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
@@ -312,7 +315,7 @@ namespace
             return E_FAIL;
 
         // Allocate temporary space (3 scanlines)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc(
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc(
             (sizeof(XMVECTOR) * (srcImage.width * 2 + destImage.width)), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
@@ -371,7 +374,7 @@ namespace
         assert(srcImage.format == destImage.format);
 
         // Allocate temporary space (3 scanlines, plus X and Y filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc(
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc(
             (sizeof(XMVECTOR) * (srcImage.width * 2 + destImage.width)), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
@@ -457,7 +460,7 @@ namespace
         assert(srcImage.format == destImage.format);
 
         // Allocate temporary space (5 scanlines, plus X and Y filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc(
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc(
             (sizeof(XMVECTOR) * (srcImage.width * 4 + destImage.width)), 16)));
         if (!scanline)
             return E_OUTOFMEMORY;
@@ -610,225 +613,1244 @@ namespace
     }
 
 
-    //--- Triangle Filter ---
-    HRESULT ResizeTriangleFilter(const Image& srcImage, TEX_FILTER_FLAGS filter, const Image& destImage) noexcept
+    //--- Custom filter resize ---
+    HRESULT PerformResizeUsingCustomFilters(const Image& srcImage, TEX_FILTER_FLAGS filter, const Image& destImage) noexcept
     {
-        assert(srcImage.pixels && destImage.pixels);
-        assert(srcImage.format == destImage.format);
+        if (!srcImage.pixels || !destImage.pixels)
+            return E_POINTER;
 
-        using namespace TriangleFilter;
+        static_assert(TEX_FILTER_POINT == 0x100000, "TEX_FILTER_ flag values don't match TEX_FILTER_MASK");
 
-        // Allocate initial temporary space (1 scanline, accumulation rows, plus X and Y filters)
-        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * srcImage.width, 16)));
-        if (!scanline)
+        unsigned long filter_select = filter & TEX_FILTER_MODE_MASK;
+        if (!filter_select)
+        {
+            // Default filter choice
+            filter_select = (((destImage.width << 1) == srcImage.width) && ((destImage.height << 1) == srcImage.height))
+                ? TEX_FILTER_BOX : TEX_FILTER_LINEAR;
+        }
+
+        switch (filter_select)
+        {
+        case TEX_FILTER_POINT:
+            return ResizePointFilter(srcImage, destImage);
+
+        case TEX_FILTER_BOX:
+            if (((destImage.width << 1) == srcImage.width) && ((destImage.height << 1) == srcImage.height))
+                return ResizeBoxFilter(srcImage, filter, destImage);
+
+            // Other ratios use the separable box kernel
+            return _ResizeSeparable(srcImage, filter, destImage);
+
+        case TEX_FILTER_LINEAR:
+            return ResizeLinearFilter(srcImage, filter, destImage);
+
+        case TEX_FILTER_CUBIC:
+            return ResizeCubicFilter(srcImage, filter, destImage);
+
+        case TEX_FILTER_TRIANGLE:
+        case TEX_FILTER_LANCZOS:
+        case TEX_FILTER_MITCHELL:
+        case TEX_FILTER_KAISER:
+            return _ResizeSeparable(srcImage, filter, destImage);
+
+        default:
+            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+        }
+    }
+}
+
+
+//-------------------------------------------------------------------------------------
+// Separable polyphase resampling
+//-------------------------------------------------------------------------------------
+namespace
+{
+    enum RESAMPLE_BOUNDARY : uint32_t
+    {
+        RESAMPLE_CLAMP = 0,
+        RESAMPLE_WRAP,
+        RESAMPLE_MIRROR,
+    };
+
+    constexpr size_t RESAMPLE_CACHE_ENTRIES = 16;
+        // Number of weight tables kept in the most-recently-used cache
+
+    constexpr float RESAMPLE_KAISER_ALPHA = 4.f;
+        // Shape parameter of the Kaiser window
+
+    //--- Weight table for one axis (one row of taps per destination pixel) ---
+    struct ResampleTable
+    {
+        size_t                          source;
+        size_t                          dest;
+        unsigned long                   kernel;
+        RESAMPLE_BOUNDARY               boundary;
+        size_t                          taps;
+        volatile long                   refCount;
+        std::unique_ptr<ptrdiff_t[]>    start;  // first source coordinate before boundary handling
+        std::unique_ptr<uint32_t[]>     index;  // dest * taps source indices after boundary handling
+        std::unique_ptr<float[]>        weight; // dest * taps normalized weights
+
+        ResampleTable() noexcept : source(0), dest(0), kernel(0), boundary(RESAMPLE_CLAMP), taps(0), refCount(1) {}
+
+        void AddRef() noexcept { InterlockedIncrement(&refCount); }
+        void Release() noexcept { if (!InterlockedDecrement(&refCount)) delete this; }
+    };
+
+    struct resample_table_release { void operator()(ResampleTable* p) const noexcept { if (p) p->Release(); } };
+
+    using ScopedResampleTable = std::unique_ptr<ResampleTable, resample_table_release>;
+
+    //--- Kernels ---
+    float KernelSupport(unsigned long kernel) noexcept
+    {
+        switch (kernel)
+        {
+        case TEX_FILTER_BOX:        return 0.5f;
+        case TEX_FILTER_TRIANGLE:   return 1.f;
+        case TEX_FILTER_MITCHELL:   return 2.f;
+        default:                    return 3.f;
+        }
+    }
+
+    float Sinc(float x) noexcept
+    {
+        if (fabsf(x) < 1e-6f)
+            return 1.f;
+
+        x *= XM_PI;
+        return sinf(x) / x;
+    }
+
+    float BesselI0(float x) noexcept
+    {
+        // Power series for the zeroth-order modified Bessel function of the first kind
+        float sum = 1.f;
+        float term = 1.f;
+        const float y = x * x * 0.25f;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= y / float(k * k);
+            sum += term;
+            if (term < sum * 1e-7f)
+                break;
+        }
+        return sum;
+    }
+
+    float EvaluateKernel(unsigned long kernel, float x) noexcept
+    {
+        x = fabsf(x);
+
+        switch (kernel)
+        {
+        case TEX_FILTER_BOX:
+            // Split samples that land exactly on the edge so the kernel stays symmetric
+            return (x < 0.5f) ? 1.f : ((x == 0.5f) ? 0.5f : 0.f);
+
+        case TEX_FILTER_TRIANGLE:
+            return (x < 1.f) ? (1.f - x) : 0.f;
+
+        case TEX_FILTER_MITCHELL:
+        {
+            // Mitchell-Netravali with B = C = 1/3
+            constexpr float B = 1.f / 3.f;
+            constexpr float C = 1.f / 3.f;
+            if (x < 1.f)
+                return ((12.f - 9.f * B - 6.f * C) * x * x * x + (-18.f + 12.f * B + 6.f * C) * x * x + (6.f - 2.f * B)) / 6.f;
+            if (x < 2.f)
+                return ((-B - 6.f * C) * x * x * x + (6.f * B + 30.f * C) * x * x + (-12.f * B - 48.f * C) * x + (8.f * B + 24.f * C)) / 6.f;
+            return 0.f;
+        }
+
+        case TEX_FILTER_LANCZOS:
+            // Lanczos with 3 lobes
+            return (x < 3.f) ? Sinc(x) * Sinc(x / 3.f) : 0.f;
+
+        case TEX_FILTER_KAISER:
+        {
+            // Kaiser-windowed sinc with 3 lobes
+            if (x >= 3.f)
+                return 0.f;
+
+            const float t = x / 3.f;
+            return Sinc(x) * BesselI0(RESAMPLE_KAISER_ALPHA * sqrtf(1.f - t * t)) / BesselI0(RESAMPLE_KAISER_ALPHA);
+        }
+
+        default:
+            return 0.f;
+        }
+    }
+
+    size_t ResolveCoordinate(ptrdiff_t j, size_t count, RESAMPLE_BOUNDARY boundary) noexcept
+    {
+        const auto n = static_cast<ptrdiff_t>(count);
+
+        switch (boundary)
+        {
+        case RESAMPLE_WRAP:
+            j %= n;
+            if (j < 0)
+                j += n;
+            return static_cast<size_t>(j);
+
+        case RESAMPLE_MIRROR:
+        {
+            const ptrdiff_t period = n * 2;
+            j %= period;
+            if (j < 0)
+                j += period;
+            return static_cast<size_t>((j >= n) ? (period - 1 - j) : j);
+        }
+
+        default:
+            return static_cast<size_t>(std::min<ptrdiff_t>(std::max<ptrdiff_t>(j, 0), n - 1));
+        }
+    }
+
+    HRESULT CreateResampleTable(
+        size_t source,
+        size_t dest,
+        unsigned long kernel,
+        RESAMPLE_BOUNDARY boundary,
+        ScopedResampleTable& result) noexcept
+    {
+        assert(source > 0 && dest > 0);
+
+        const float scale = float(source) / float(dest);
+
+        // Widen the kernel when minifying so it also acts as the low-pass filter
+        const float fscale = std::max(scale, 1.f);
+        const float support = KernelSupport(kernel) * fscale;
+
+        const size_t taps = static_cast<size_t>(ceilf(support * 2.f)) + 1;
+
+        uint64_t entries = uint64_t(dest) * uint64_t(taps);
+        if (entries > (SIZE_MAX / sizeof(float)))
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        ScopedResampleTable table(new (std::nothrow) ResampleTable);
+        if (!table)
             return E_OUTOFMEMORY;
 
-        std::unique_ptr<TriangleRow[]> rowActive(new (std::nothrow) TriangleRow[destImage.height]);
-        if (!rowActive)
+        table->source = source;
+        table->dest = dest;
+        table->kernel = kernel;
+        table->boundary = boundary;
+        table->taps = taps;
+        table->start.reset(new (std::nothrow) ptrdiff_t[dest]);
+        table->index.reset(new (std::nothrow) uint32_t[static_cast<size_t>(entries)]);
+        table->weight.reset(new (std::nothrow) float[static_cast<size_t>(entries)]);
+        if (!table->start || !table->index || !table->weight)
+            return E_OUTOFMEMORY;
+
+        const float invscale = 1.f / fscale;
+
+        for (size_t i = 0; i < dest; ++i)
+        {
+            const float center = (float(i) + 0.5f) * scale - 0.5f;
+            const auto left = static_cast<ptrdiff_t>(ceilf(center - support));
+
+            table->start[i] = left;
+
+            uint32_t* index = &table->index[i * taps];
+            float* weight = &table->weight[i * taps];
+
+            float total = 0.f;
+            for (size_t k = 0; k < taps; ++k)
+            {
+                const ptrdiff_t j = left + static_cast<ptrdiff_t>(k);
+                index[k] = static_cast<uint32_t>(ResolveCoordinate(j, source, boundary));
+                weight[k] = EvaluateKernel(kernel, (float(j) - center) * invscale);
+                total += weight[k];
+            }
+
+            if (fabsf(total) < 1e-6f)
+            {
+                // Degenerate case, so fall back to the nearest source pixel
+                memset(weight, 0, sizeof(float) * taps);
+                auto k = static_cast<ptrdiff_t>(floorf(center + 0.5f)) - left;
+                k = std::min<ptrdiff_t>(std::max<ptrdiff_t>(k, 0), static_cast<ptrdiff_t>(taps) - 1);
+                weight[k] = 1.f;
+            }
+            else
+            {
+                const float norm = 1.f / total;
+                for (size_t k = 0; k < taps; ++k)
+                {
+                    weight[k] *= norm;
+                }
+            }
+        }
+
+        result = std::move(table);
+
+        return S_OK;
+    }
+
+    //--- Most-recently-used cache of weight tables ---
+    class ResampleTableCache
+    {
+    public:
+        ResampleTableCache() noexcept : m_lock{}, m_tables{}
+        {
+            InitializeSRWLock(&m_lock);
+        }
+
+        ResampleTableCache(ResampleTableCache const&) = delete;
+        ResampleTableCache& operator=(ResampleTableCache const&) = delete;
+
+        ~ResampleTableCache()
+        {
+            for (auto& it : m_tables)
+            {
+                if (it)
+                {
+                    it->Release();
+                    it = nullptr;
+                }
+            }
+        }
+
+        HRESULT Get(
+            size_t source,
+            size_t dest,
+            unsigned long kernel,
+            RESAMPLE_BOUNDARY boundary,
+            ScopedResampleTable& result) noexcept
+        {
+            AcquireSRWLockExclusive(&m_lock);
+            ResampleTable* table = Find(source, dest, kernel, boundary);
+            ReleaseSRWLockExclusive(&m_lock);
+
+            if (table)
+            {
+                result.reset(table);
+                return S_OK;
+            }
+
+            // Build outside of the lock since large tables take a while
+            ScopedResampleTable created;
+            HRESULT hr = CreateResampleTable(source, dest, kernel, boundary, created);
+            if (FAILED(hr))
+                return hr;
+
+            AcquireSRWLockExclusive(&m_lock);
+            table = Find(source, dest, kernel, boundary);
+            if (!table)
+            {
+                // Insert at the front, dropping the least-recently-used entry
+                if (m_tables[RESAMPLE_CACHE_ENTRIES - 1])
+                    m_tables[RESAMPLE_CACHE_ENTRIES - 1]->Release();
+
+                memmove(&m_tables[1], &m_tables[0], sizeof(ResampleTable*) * (RESAMPLE_CACHE_ENTRIES - 1));
+
+                table = created.release();
+                table->AddRef();
+                m_tables[0] = table;
+            }
+            ReleaseSRWLockExclusive(&m_lock);
+
+            result.reset(table);
+            return S_OK;
+        }
+
+    private:
+        // Must be called with the lock held; returns an extra reference and moves the entry to the front
+        ResampleTable* Find(size_t source, size_t dest, unsigned long kernel, RESAMPLE_BOUNDARY boundary) noexcept
+        {
+            for (size_t j = 0; j < RESAMPLE_CACHE_ENTRIES && m_tables[j]; ++j)
+            {
+                ResampleTable* table = m_tables[j];
+                if (table->source == source && table->dest == dest && table->kernel == kernel && table->boundary == boundary)
+                {
+                    memmove(&m_tables[1], &m_tables[0], sizeof(ResampleTable*) * j);
+                    m_tables[0] = table;
+                    table->AddRef();
+                    return table;
+                }
+            }
+
+            return nullptr;
+        }
+
+        SRWLOCK         m_lock;
+        ResampleTable*  m_tables[RESAMPLE_CACHE_ENTRIES];
+    };
+
+    ResampleTableCache g_resampleCache;
+
+    RESAMPLE_BOUNDARY GetBoundary(TEX_FILTER_FLAGS filter, unsigned long wrap, unsigned long mirror) noexcept
+    {
+        if (filter & wrap)
+            return RESAMPLE_WRAP;
+
+        return (filter & mirror) ? RESAMPLE_MIRROR : RESAMPLE_CLAMP;
+    }
+}
+
+//-------------------------------------------------------------------------------------
+// Resizes using a separable kernel: a horizontal pass per source row into a ring
+// buffer, followed by a vertical pass per destination row
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::_ResizeSeparable(const Image& srcImage, TEX_FILTER_FLAGS filter, const Image& destImage, const Rect* destRect) noexcept
+{
+    if (!srcImage.pixels || !destImage.pixels)
+        return E_POINTER;
+
+    assert(srcImage.format == destImage.format);
+
+    if ((srcImage.width > UINT32_MAX) || (srcImage.height > UINT32_MAX))
+        return E_INVALIDARG;
+
+    unsigned long kernel = filter & TEX_FILTER_MODE_MASK;
+    switch (kernel)
+    {
+    case TEX_FILTER_BOX:
+    case TEX_FILTER_TRIANGLE:
+    case TEX_FILTER_LANCZOS:
+    case TEX_FILTER_MITCHELL:
+    case TEX_FILTER_KAISER:
+        break;
+
+    default:
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    ScopedResampleTable tX;
+    HRESULT hr = g_resampleCache.Get(srcImage.width, destImage.width, kernel,
+        GetBoundary(filter, TEX_FILTER_WRAP_U, TEX_FILTER_MIRROR_U), tX);
+    if (FAILED(hr))
+        return hr;
+
+    ScopedResampleTable tY;
+    hr = g_resampleCache.Get(srcImage.height, destImage.height, kernel,
+        GetBoundary(filter, TEX_FILTER_WRAP_V, TEX_FILTER_MIRROR_V), tY);
+    if (FAILED(hr))
+        return hr;
+
+    const size_t tapsX = tX->taps;
+    const size_t tapsY = tY->taps;
+
+    // Destination pixels to produce, and the source columns they read
+    size_t x0 = 0;
+    size_t x1 = destImage.width;
+    size_t y0 = 0;
+    size_t y1 = destImage.height;
+    size_t sx0 = 0;
+    size_t sx1 = srcImage.width;
+
+    const size_t bpp = _ScanlineSpanPixelBytes(srcImage.format);
+    if (destRect)
+    {
+        if (!destRect->w || !destRect->h
+            || destRect->x >= destImage.width || destRect->w > (destImage.width - destRect->x)
+            || destRect->y >= destImage.height || destRect->h > (destImage.height - destRect->y))
+            return E_INVALIDARG;
+
+        y0 = destRect->y;
+        y1 = y0 + destRect->h;
+
+        if (bpp)
+        {
+            // Otherwise whole rows are produced, since a partial row can't be stored
+            x0 = destRect->x;
+            x1 = x0 + destRect->w;
+
+            sx0 = srcImage.width;
+            sx1 = 0;
+            for (size_t i = x0 * tapsX; i < x1 * tapsX; ++i)
+            {
+                sx0 = std::min<size_t>(sx0, tX->index[i]);
+                sx1 = std::max<size_t>(sx1, size_t(tX->index[i]) + 1);
+            }
+        }
+    }
+
+    const bool span = (sx0 > 0 || sx1 < srcImage.width);
+
+    // Allocate temporary space (1 source scanline, 1 target scanline, plus ring of filtered rows)
+    uint64_t scanlines = uint64_t(srcImage.width) + uint64_t(destImage.width) * (uint64_t(tapsY) + 1);
+    if (scanlines > (SIZE_MAX / sizeof(XMVECTOR)))
+        return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+    ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc(sizeof(XMVECTOR) * static_cast<size_t>(scanlines), 16)));
+    if (!scanline)
+        return E_OUTOFMEMORY;
+
+    std::unique_ptr<ptrdiff_t[]> ringRow(new (std::nothrow) ptrdiff_t[tapsY]);
+    if (!ringRow)
+        return E_OUTOFMEMORY;
+
+    for (size_t k = 0; k < tapsY; ++k)
+    {
+        ringRow[k] = PTRDIFF_MIN;
+    }
+
+    XMVECTOR* row = scanline.get();
+    XMVECTOR* target = row + srcImage.width;
+    XMVECTOR* ring = target + destImage.width;
+
+    const uint8_t* pSrc = srcImage.pixels;
+    uint8_t* pDest = destImage.pixels + (destImage.rowPitch * y0);
+
+    for (size_t y = y0; y < y1; ++y)
+    {
+        const ptrdiff_t start = tY->start[y];
+        const float* wy = &tY->weight[y * tapsY];
+
+        // Horizontal pass for any source rows not already in the ring (slots follow the unresolved
+        // coordinate, so a window of tapsY consecutive rows never collides)
+        for (size_t k = 0; k < tapsY; ++k)
+        {
+            const ptrdiff_t j = start + static_cast<ptrdiff_t>(k);
+            const auto slot = static_cast<size_t>(((j % static_cast<ptrdiff_t>(tapsY)) + static_cast<ptrdiff_t>(tapsY)) % static_cast<ptrdiff_t>(tapsY));
+            if (ringRow[slot] == j)
+                continue;
+
+            const size_t v = tY->index[y * tapsY + k];
+            const uint8_t* pRow = pSrc + (srcImage.rowPitch * v);
+            if (span)
+            {
+                if (!_LoadScanlineLinear(row + sx0, sx1 - sx0, pRow + (sx0 * bpp), (sx1 - sx0) * bpp, srcImage.format, filter))
+                    return E_FAIL;
+            }
+            else if (!_LoadScanlineLinear(row, srcImage.width, pRow, srcImage.rowPitch, srcImage.format, filter))
+                return E_FAIL;
+
+            XMVECTOR* hrow = ring + slot * destImage.width;
+            const uint32_t* ix = tX->index.get() + x0 * tapsX;
+            const float* wx = tX->weight.get() + x0 * tapsX;
+            for (size_t x = x0; x < x1; ++x, ix += tapsX, wx += tapsX)
+            {
+                XMVECTOR acc = XMVectorZero();
+                for (size_t t = 0; t < tapsX; ++t)
+                {
+                    acc = XMVectorMultiplyAdd(row[ix[t]], XMVectorReplicate(wx[t]), acc);
+                }
+                hrow[x] = acc;
+            }
+
+            ringRow[slot] = j;
+        }
+
+        // Vertical pass
+        for (size_t k = 0; k < tapsY; ++k)
+        {
+            const ptrdiff_t j = start + static_cast<ptrdiff_t>(k);
+            const auto slot = static_cast<size_t>(((j % static_cast<ptrdiff_t>(tapsY)) + static_cast<ptrdiff_t>(tapsY)) % static_cast<ptrdiff_t>(tapsY));
+            const XMVECTOR* hrow = ring + slot * destImage.width;
+            const XMVECTOR weight = XMVectorReplicate(wy[k]);
+
+            if (!k)
+            {
+                for (size_t x = x0; x < x1; ++x)
+                {
+                    target[x] = XMVectorMultiply(hrow[x], weight);
+                }
+            }
+            else if (wy[k] != 0.f)
+            {
+                for (size_t x = x0; x < x1; ++x)
+                {
+                    target[x] = XMVectorMultiplyAdd(hrow[x], weight, target[x]);
+                }
+            }
+        }
+
+        // This performs any required clamping
+        if (x0 > 0 || x1 < destImage.width)
+        {
+            if (!_StoreScanlineLinear(pDest + (x0 * bpp), (x1 - x0) * bpp, destImage.format, target + x0, x1 - x0, filter))
+                return E_FAIL;
+        }
+        else if (!_StoreScanlineLinear(pDest, destImage.rowPitch, destImage.format, target, destImage.width, filter))
+            return E_FAIL;
+        pDest += destImage.rowPitch;
+    }
+
+    return S_OK;
+}
+
+
+//-------------------------------------------------------------------------------------
+// Exposes the source coordinates of a separable resize along one axis, so callers can
+// work out which destination pixels a change to the source touches
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::_GetResampleTaps(
+    size_t source,
+    size_t dest,
+    TEX_FILTER_FLAGS filter,
+    bool vertical,
+    size_t& taps,
+    std::unique_ptr<uint32_t[]>& index) noexcept
+{
+    taps = 0;
+    index.reset();
+
+    if (!source || !dest || source > UINT32_MAX)
+        return E_INVALIDARG;
+
+    ScopedResampleTable table;
+    HRESULT hr = g_resampleCache.Get(source, dest, filter & TEX_FILTER_MODE_MASK,
+        (vertical)
+        ? GetBoundary(filter, TEX_FILTER_WRAP_V, TEX_FILTER_MIRROR_V)
+        : GetBoundary(filter, TEX_FILTER_WRAP_U, TEX_FILTER_MIRROR_U), table);
+    if (FAILED(hr))
+        return hr;
+
+    index.reset(new (std::nothrow) uint32_t[dest * table->taps]);
+    if (!index)
+        return E_OUTOFMEMORY;
+
+    memcpy(index.get(), table->index.get(), sizeof(uint32_t) * dest * table->taps);
+    taps = table->taps;
+
+    return S_OK;
+}
+
+
+//-------------------------------------------------------------------------------------
+// Integer-ratio downscale: whole-factor box and triangle reductions of UNORM formats
+// done directly on the 8-bit or 16-bit channels, without float scanline conversion
+//-------------------------------------------------------------------------------------
+namespace
+{
+    constexpr size_t RESIZE_MAX_INTEGER_RATIO = 8;
+        // Largest reduction factor per axis handled by the integer kernels
+
+    constexpr uint32_t RESIZE_WEIGHT_BITS = 14;
+        // Fixed-point precision of the integer triangle weights
+
+    // Bytes per channel when every channel is UNORM of the same size and is filtered as stored, otherwise 0
+    size_t IntegerResizeChannelBytes(DXGI_FORMAT format, TEX_FILTER_FLAGS filter) noexcept
+    {
+        if (filter & TEX_FILTER_SRGB_MASK)
+            return 0;
+
+        switch (format)
+        {
+        case DXGI_FORMAT_R8G8B8A8_UNORM:
+        case DXGI_FORMAT_B8G8R8A8_UNORM:
+        case DXGI_FORMAT_R8G8_UNORM:
+        case DXGI_FORMAT_R8_UNORM:
+        case DXGI_FORMAT_A8_UNORM:
+            return 1;
+
+        case DXGI_FORMAT_R16G16B16A16_UNORM:
+        case DXGI_FORMAT_R16G16_UNORM:
+        case DXGI_FORMAT_R16_UNORM:
+            return 2;
+
+        default:
+            return 0;
+        }
+    }
+
+    bool UseIntegerRatioResize(
+        DXGI_FORMAT format,
+        size_t srcWidth,
+        size_t srcHeight,
+        size_t width,
+        size_t height,
+        TEX_FILTER_FLAGS filter) noexcept
+    {
+        const size_t bytes = IntegerResizeChannelBytes(format, filter);
+        switch (filter & TEX_FILTER_MODE_MASK)
+        {
+        case TEX_FILTER_BOX:
+            if (!bytes)
+                return false;
+            break;
+
+        case TEX_FILTER_TRIANGLE:
+            // Fixed-point weights are only within rounding of the float kernel for 8-bit channels
+            if (bytes != 1)
+                return false;
+            break;
+
+        default:
+            return false;
+        }
+
+        if (!width || !height || (srcWidth % width) || (srcHeight % height))
+            return false;
+
+        const size_t rx = srcWidth / width;
+        const size_t ry = srcHeight / height;
+        return (rx <= RESIZE_MAX_INTEGER_RATIO) && (ry <= RESIZE_MAX_INTEGER_RATIO) && (rx > 1 || ry > 1);
+    }
+
+    // Adds a row of channels to 32-bit column sums
+    void AccumulateColumns(
+        _Inout_updates_(count) uint32_t* sums,
+        _In_reads_bytes_(count * bytes) const uint8_t* pSrc,
+        size_t count,
+        size_t bytes) noexcept
+    {
+        size_t i = 0;
+
+        if (bytes == 1)
+        {
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+            const __m128i zero = _mm_setzero_si128();
+            for (; (i + 16) <= count; i += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+                const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+                __m128i* s = reinterpret_cast<__m128i*>(sums + i);
+                _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s), _mm_unpacklo_epi16(lo, zero)));
+                _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), _mm_unpackhi_epi16(lo, zero)));
+                _mm_storeu_si128(s + 2, _mm_add_epi32(_mm_loadu_si128(s + 2), _mm_unpacklo_epi16(hi, zero)));
+                _mm_storeu_si128(s + 3, _mm_add_epi32(_mm_loadu_si128(s + 3), _mm_unpackhi_epi16(hi, zero)));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                sums[i] += pSrc[i];
+            }
+        }
+        else
+        {
+            auto pSrc16 = reinterpret_cast<const uint16_t*>(pSrc);
+
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+            const __m128i zero = _mm_setzero_si128();
+            for (; (i + 8) <= count; i += 8)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc16 + i));
+
+                __m128i* s = reinterpret_cast<__m128i*>(sums + i);
+                _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s), _mm_unpacklo_epi16(v, zero)));
+                _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), _mm_unpackhi_epi16(v, zero)));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                sums[i] += pSrc16[i];
+            }
+        }
+    }
+
+    // Adds a row of 8-bit channels scaled by a fixed-point weight to 32-bit column sums
+    void AccumulateWeightedColumns(
+        _Inout_updates_(count) uint32_t* sums,
+        _In_reads_(count) const uint8_t* pSrc,
+        size_t count,
+        uint32_t weight) noexcept
+    {
+        size_t i = 0;
+
+#if defined(_XM_SSE_INTRINSICS_) && !defined(_XM_NO_INTRINSICS_)
+        // Channels are interleaved with zeros so each 16-bit multiply-add yields one 32-bit product
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i w = _mm_set1_epi32(static_cast<int>(weight));
+        for (; (i + 16) <= count; i += 16)
+        {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc + i));
+            const __m128i lo = _mm_unpacklo_epi8(v, zero);
+            const __m128i hi = _mm_unpackhi_epi8(v, zero);
+
+            __m128i* s = reinterpret_cast<__m128i*>(sums + i);
+            _mm_storeu_si128(s, _mm_add_epi32(_mm_loadu_si128(s), _mm_madd_epi16(_mm_unpacklo_epi16(lo, zero), w)));
+            _mm_storeu_si128(s + 1, _mm_add_epi32(_mm_loadu_si128(s + 1), _mm_madd_epi16(_mm_unpackhi_epi16(lo, zero), w)));
+            _mm_storeu_si128(s + 2, _mm_add_epi32(_mm_loadu_si128(s + 2), _mm_madd_epi16(_mm_unpacklo_epi16(hi, zero), w)));
+            _mm_storeu_si128(s + 3, _mm_add_epi32(_mm_loadu_si128(s + 3), _mm_madd_epi16(_mm_unpackhi_epi16(hi, zero), w)));
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            sums[i] += weight * pSrc[i];
+        }
+    }
+
+    inline void StoreChannel(_Out_writes_bytes_(bytes) uint8_t* pDest, size_t bytes, uint32_t value) noexcept
+    {
+        if (bytes == 1)
+        {
+            *pDest = static_cast<uint8_t>(value);
+        }
+        else
+        {
+            *reinterpret_cast<uint16_t*>(pDest) = static_cast<uint16_t>(value);
+        }
+    }
+
+    //--- N x M box ---
+    HRESULT ResizeIntegerBox(const Image& srcImage, const Image& destImage, size_t bytes) noexcept
+    {
+        const size_t rx = srcImage.width / destImage.width;
+        const size_t ry = srcImage.height / destImage.height;
+        const size_t area = rx * ry;
+
+        const size_t channels = BitsPerPixel(srcImage.format) / (bytes * 8);
+        const size_t count = srcImage.width * channels;
+
+        std::unique_ptr<uint32_t[]> sums(new (std::nothrow) uint32_t[count]);
+        if (!sums)
             return E_OUTOFMEMORY;
 
-        TriangleRow * rowFree = nullptr;
+        // (sum + area/2) * recip >> 32 is the rounded quotient for all sums of up to 64 16-bit values
+        const uint64_t recip = ((uint64_t(1) << 32) + area - 1) / area;
+        const uint32_t bias = static_cast<uint32_t>(area >> 1);
+
+        const uint8_t* pSrc = srcImage.pixels;
+        uint8_t* pDest = destImage.pixels;
+
+        for (size_t y = 0; y < destImage.height; ++y)
+        {
+            memset(sums.get(), 0, sizeof(uint32_t) * count);
+
+            for (size_t k = 0; k < ry; ++k)
+            {
+                AccumulateColumns(sums.get(), pSrc, count, bytes);
+                pSrc += srcImage.rowPitch;
+            }
+
+            const uint32_t* col = sums.get();
+            uint8_t* pOut = pDest;
+            for (size_t x = 0; x < destImage.width; ++x, col += rx * channels)
+            {
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    uint32_t sum = bias;
+                    for (size_t j = 0; j < rx; ++j)
+                    {
+                        sum += col[j * channels + c];
+                    }
+
+                    StoreChannel(pOut, bytes, static_cast<uint32_t>((uint64_t(sum) * recip) >> 32));
+                    pOut += bytes;
+                }
+            }
+
+            pDest += destImage.rowPitch;
+        }
+
+        return S_OK;
+    }
+
+    // Rounds a weight table to fixed point, keeping each destination's weights summing to exactly 1
+    void QuantizeResampleWeights(const ResampleTable& table, _Out_writes_(table.dest * table.taps) uint32_t* weights) noexcept
+    {
+        const uint32_t one = 1u << RESIZE_WEIGHT_BITS;
+
+        for (size_t d = 0; d < table.dest; ++d)
+        {
+            const float* src = &table.weight[d * table.taps];
+            uint32_t* dst = weights + d * table.taps;
+
+            uint32_t total = 0;
+            size_t largest = 0;
+            for (size_t t = 0; t < table.taps; ++t)
+            {
+                dst[t] = static_cast<uint32_t>(std::max(src[t], 0.f) * float(one) + 0.5f);
+                total += dst[t];
+                if (dst[t] > dst[largest])
+                    largest = t;
+            }
+
+            dst[largest] = dst[largest] + one - total;
+        }
+    }
 
-        std::unique_ptr<Filter> tfX;
-        HRESULT hr = _Create(srcImage.width, destImage.width, (filter & TEX_FILTER_WRAP_U) != 0, tfX);
+    //--- Separable triangle on 8-bit channels (vertical pass on whole rows, then horizontal) ---
+    HRESULT ResizeIntegerTriangle(const Image& srcImage, TEX_FILTER_FLAGS filter, const Image& destImage) noexcept
+    {
+        ScopedResampleTable tX;
+        HRESULT hr = g_resampleCache.Get(srcImage.width, destImage.width, TEX_FILTER_TRIANGLE,
+            GetBoundary(filter, TEX_FILTER_WRAP_U, TEX_FILTER_MIRROR_U), tX);
         if (FAILED(hr))
             return hr;
 
-        std::unique_ptr<Filter> tfY;
-        hr = _Create(srcImage.height, destImage.height, (filter & TEX_FILTER_WRAP_V) != 0, tfY);
+        ScopedResampleTable tY;
+        hr = g_resampleCache.Get(srcImage.height, destImage.height, TEX_FILTER_TRIANGLE,
+            GetBoundary(filter, TEX_FILTER_WRAP_V, TEX_FILTER_MIRROR_V), tY);
         if (FAILED(hr))
             return hr;
 
-        XMVECTOR* row = scanline.get();
+        const size_t tapsX = tX->taps;
+        const size_t tapsY = tY->taps;
 
-#ifdef _DEBUG
-        memset(row, 0xCD, sizeof(XMVECTOR)*srcImage.width);
-#endif
+        const size_t channels = BitsPerPixel(srcImage.format) / 8;
+        const size_t count = srcImage.width * channels;
 
-        auto xFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfX.get()) + tfX->sizeInBytes);
-        auto yFromEnd = reinterpret_cast<const FilterFrom*>(reinterpret_cast<const uint8_t*>(tfY.get()) + tfY->sizeInBytes);
+        std::unique_ptr<uint32_t[]> buffer(new (std::nothrow) uint32_t[count + destImage.width * tapsX + destImage.height * tapsY]);
+        if (!buffer)
+            return E_OUTOFMEMORY;
 
-        // Count times rows get written
-        for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
-        {
-            for (size_t j = 0; j < yFrom->count; ++j)
-            {
-                size_t v = yFrom->to[j].u;
-                assert(v < destImage.height);
-                ++rowActive[v].remaining;
-            }
+        uint32_t* sums = buffer.get();
+        uint32_t* wx = sums + count;
+        uint32_t* wy = wx + destImage.width * tapsX;
 
-            yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
-        }
+        QuantizeResampleWeights(*tX, wx);
+        QuantizeResampleWeights(*tY, wy);
 
-        // Filter image
-        const uint8_t* pSrc = srcImage.pixels;
-        size_t rowPitch = srcImage.rowPitch;
-        const uint8_t* pEndSrc = pSrc + rowPitch * srcImage.height;
+        const uint64_t round = uint64_t(1) << (RESIZE_WEIGHT_BITS * 2 - 1);
 
         uint8_t* pDest = destImage.pixels;
 
-        for (FilterFrom* yFrom = tfY->from; yFrom < yFromEnd; )
+        for (size_t y = 0; y < destImage.height; ++y)
         {
-            // Create accumulation rows as needed
-            for (size_t j = 0; j < yFrom->count; ++j)
+            // Vertical pass: each column sum is at most 255 << RESIZE_WEIGHT_BITS
+            memset(sums, 0, sizeof(uint32_t) * count);
+
+            for (size_t k = 0; k < tapsY; ++k)
             {
-                size_t v = yFrom->to[j].u;
-                assert(v < destImage.height);
-                TriangleRow* rowAcc = &rowActive[v];
+                const uint32_t w = wy[y * tapsY + k];
+                if (w)
+                {
+                    AccumulateWeightedColumns(sums, srcImage.pixels + (srcImage.rowPitch * tY->index[y * tapsY + k]), count, w);
+                }
+            }
 
-                if (!rowAcc->scanline)
+            // Horizontal pass
+            const uint32_t* ix = tX->index.get();
+            const uint32_t* w = wx;
+            uint8_t* pOut = pDest;
+            for (size_t x = 0; x < destImage.width; ++x, ix += tapsX, w += tapsX)
+            {
+                for (size_t c = 0; c < channels; ++c)
                 {
-                    if (rowFree)
-                    {
-                        // Steal and reuse scanline from 'free row' list
-                        assert(rowFree->scanline != nullptr);
-                        rowAcc->scanline.reset(rowFree->scanline.release());
-                        rowFree = rowFree->next;
-                    }
-                    else
+                    uint64_t acc = round;
+                    for (size_t t = 0; t < tapsX; ++t)
                     {
-                        rowAcc->scanline.reset(static_cast<XMVECTOR*>(_aligned_malloc(sizeof(XMVECTOR) * destImage.width, 16)));
-                        if (!rowAcc->scanline)
-                            return E_OUTOFMEMORY;
+                        acc += uint64_t(w[t]) * sums[ix[t] * channels + c];
                     }
 
-                    memset(rowAcc->scanline.get(), 0, sizeof(XMVECTOR) * destImage.width);
+                    *(pOut++) = static_cast<uint8_t>(std::min<uint64_t>(acc >> (RESIZE_WEIGHT_BITS * 2), 0xFF));
                 }
             }
 
-            // Load source scanline
-            if ((pSrc + rowPitch) > pEndSrc)
-                return E_FAIL;
+            pDest += destImage.rowPitch;
+        }
 
-            if (!_LoadScanlineLinear(row, srcImage.width, pSrc, rowPitch, srcImage.format, filter))
-                return E_FAIL;
+        return S_OK;
+    }
 
-            pSrc += rowPitch;
+    HRESULT ResizeIntegerRatio(const Image& srcImage, TEX_FILTER_FLAGS filter, const Image& destImage) noexcept
+    {
+        if (!srcImage.pixels || !destImage.pixels)
+            return E_POINTER;
 
-            // Process row
-            size_t x = 0;
-            for (FilterFrom* xFrom = tfX->from; xFrom < xFromEnd; ++x)
-            {
-                for (size_t j = 0; j < yFrom->count; ++j)
-                {
-                    size_t v = yFrom->to[j].u;
-                    assert(v < destImage.height);
-                    float yweight = yFrom->to[j].weight;
+        assert(srcImage.format == destImage.format);
+        assert(UseIntegerRatioResize(srcImage.format, srcImage.width, srcImage.height, destImage.width, destImage.height, filter));
 
-                    XMVECTOR* accPtr = rowActive[v].scanline.get();
-                    if (!accPtr)
-                        return E_POINTER;
+        const size_t bytes = IntegerResizeChannelBytes(srcImage.format, filter);
 
-                    for (size_t k = 0; k < xFrom->count; ++k)
-                    {
-                        size_t u = xFrom->to[k].u;
-                        assert(u < destImage.width);
+        return ((filter & TEX_FILTER_MODE_MASK) == TEX_FILTER_BOX)
+            ? ResizeIntegerBox(srcImage, destImage, bytes)
+            : ResizeIntegerTriangle(srcImage, filter, destImage);
+    }
+}
 
-                        XMVECTOR weight = XMVectorReplicate(yweight * xFrom->to[k].weight);
 
-                        assert(x < srcImage.width);
-                        accPtr[u] = XMVectorMultiplyAdd(row[x], weight, accPtr[u]);
-                    }
-                }
+//-------------------------------------------------------------------------------------
+// Multi-output separable resize: every source row is decoded once, filtered horizontally
+// once per distinct target width, and then accumulated into the destination rows of each
+// target that it contributes to
+//-------------------------------------------------------------------------------------
+namespace
+{
+    struct ResizeOutput
+    {
+        const Image*                        dest;
+        size_t                              hrowIndex;      // which horizontal row this target reads
+        ScopedResampleTable                 tX;
+        ScopedResampleTable                 tY;
+        std::unique_ptr<uint32_t[]>         rowStart;       // per source row, first entry in rowDest/rowWeight
+        std::unique_ptr<uint32_t[]>         rowDest;        // destination row for each (source row, tap)
+        std::unique_ptr<float[]>            rowWeight;      // vertical weight for each (source row, tap)
+        std::unique_ptr<uint32_t[]>         remaining;      // taps still to be accumulated per destination row
+        std::unique_ptr<XMVECTOR*[]>        active;         // accumulation row per destination row
+        std::unique_ptr<XMVECTOR*[]>        freeRows;
+        size_t                              freeCount;
+        ScopedAlignedArrayXMVECTOR          pool;
+
+        ResizeOutput() noexcept : dest(nullptr), hrowIndex(0), freeCount(0) {}
+    };
+
+    HRESULT SetupResizeOutput(
+        const Image& srcImage,
+        TEX_FILTER_FLAGS filter,
+        unsigned long kernel,
+        const Image& destImage,
+        ResizeOutput& output) noexcept
+    {
+        output.dest = &destImage;
 
-                xFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(xFrom) + xFrom->sizeInBytes);
-            }
+        HRESULT hr = g_resampleCache.Get(srcImage.width, destImage.width, kernel,
+            GetBoundary(filter, TEX_FILTER_WRAP_U, TEX_FILTER_MIRROR_U), output.tX);
+        if (FAILED(hr))
+            return hr;
+
+        hr = g_resampleCache.Get(srcImage.height, destImage.height, kernel,
+            GetBoundary(filter, TEX_FILTER_WRAP_V, TEX_FILTER_MIRROR_V), output.tY);
+        if (FAILED(hr))
+            return hr;
+
+        const ResampleTable* tY = output.tY.get();
+        const size_t taps = tY->taps;
+        const size_t entries = destImage.height * taps;
+        if (entries > UINT32_MAX)
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        output.rowStart.reset(new (std::nothrow) uint32_t[srcImage.height + 1]);
+        output.rowDest.reset(new (std::nothrow) uint32_t[entries]);
+        output.rowWeight.reset(new (std::nothrow) float[entries]);
+        output.remaining.reset(new (std::nothrow) uint32_t[destImage.height]);
+        output.active.reset(new (std::nothrow) XMVECTOR*[destImage.height]);
+        std::unique_ptr<ptrdiff_t[]> span(new (std::nothrow) ptrdiff_t[srcImage.height + 1]);
+        if (!output.rowStart || !output.rowDest || !output.rowWeight || !output.remaining || !output.active || !span)
+            return E_OUTOFMEMORY;
+
+        // Invert the vertical table so that each source row lists the destination rows it feeds
+        memset(output.rowStart.get(), 0, sizeof(uint32_t) * (srcImage.height + 1));
+        memset(span.get(), 0, sizeof(ptrdiff_t) * (srcImage.height + 1));
 
-            // Write completed accumulation rows
-            for (size_t j = 0; j < yFrom->count; ++j)
+        for (size_t y = 0; y < destImage.height; ++y)
+        {
+            uint32_t count = 0;
+            size_t first = srcImage.height;
+            size_t last = 0;
+            for (size_t k = 0; k < taps; ++k)
             {
-                size_t v = yFrom->to[j].u;
-                assert(v < destImage.height);
-                TriangleRow* rowAcc = &rowActive[v];
+                if (tY->weight[y * taps + k] == 0.f)
+                    continue;
+
+                const size_t v = tY->index[y * taps + k];
+                ++output.rowStart[v + 1];
+                ++count;
+                first = std::min(first, v);
+                last = std::max(last, v);
+            }
 
-                assert(rowAcc->remaining > 0);
-                --rowAcc->remaining;
+            assert(count > 0);
+            output.remaining[y] = count;
+            output.active[y] = nullptr;
 
-                if (!rowAcc->remaining)
-                {
-                    XMVECTOR* pAccSrc = rowAcc->scanline.get();
-                    if (!pAccSrc)
-                        return E_POINTER;
+            // A destination row is live from its first to its last source row
+            ++span[first];
+            --span[last + 1];
+        }
 
-                    switch (destImage.format)
-                    {
-                    case DXGI_FORMAT_R10G10B10A2_UNORM:
-                    case DXGI_FORMAT_R10G10B10A2_UINT:
-                    {
-                        // Need to slightly bias results for floating-point error accumulation which can
-                        // be visible with harshly quantized values
-                        static const XMVECTORF32 Bias = { { { 0.f, 0.f, 0.f, 0.1f } } };
+        for (size_t v = 0; v < srcImage.height; ++v)
+        {
+            output.rowStart[v + 1] += output.rowStart[v];
+        }
 
-                        XMVECTOR* ptr = pAccSrc;
-                        for (size_t i = 0; i < destImage.width; ++i, ++ptr)
-                        {
-                            *ptr = XMVectorAdd(*ptr, Bias);
-                        }
-                    }
-                    break;
+        std::unique_ptr<uint32_t[]> fill(new (std::nothrow) uint32_t[srcImage.height]);
+        if (!fill)
+            return E_OUTOFMEMORY;
 
-                    default:
-                        break;
-                    }
+        memcpy(fill.get(), output.rowStart.get(), sizeof(uint32_t) * srcImage.height);
 
-                    // This performs any required clamping
-                    if (!_StoreScanlineLinear(pDest + (destImage.rowPitch * v), destImage.rowPitch, destImage.format, pAccSrc, destImage.width, filter))
-                        return E_FAIL;
+        for (size_t y = 0; y < destImage.height; ++y)
+        {
+            for (size_t k = 0; k < taps; ++k)
+            {
+                const float w = tY->weight[y * taps + k];
+                if (w == 0.f)
+                    continue;
 
-                    // Put row on freelist to reuse it's allocated scanline
-                    rowAcc->next = rowFree;
-                    rowFree = rowAcc;
-                }
+                const uint32_t e = fill[tY->index[y * taps + k]]++;
+                output.rowDest[e] = static_cast<uint32_t>(y);
+                output.rowWeight[e] = w;
             }
+        }
+
+        // Size the accumulation row pool for the most destination rows live at once
+        size_t maxLive = 0;
+        ptrdiff_t live = 0;
+        for (size_t v = 0; v < srcImage.height; ++v)
+        {
+            live += span[v];
+            maxLive = std::max(maxLive, static_cast<size_t>(live));
+        }
+
+        uint64_t poolSize = uint64_t(maxLive) * uint64_t(destImage.width);
+        if (poolSize > (SIZE_MAX / sizeof(XMVECTOR)))
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
 
-            yFrom = reinterpret_cast<FilterFrom*>(reinterpret_cast<uint8_t*>(yFrom) + yFrom->sizeInBytes);
+        output.pool.reset(static_cast<XMVECTOR*>(_AlignedAlloc(sizeof(XMVECTOR) * static_cast<size_t>(poolSize), 16)));
+        output.freeRows.reset(new (std::nothrow) XMVECTOR*[maxLive]);
+        if (!output.pool || !output.freeRows)
+            return E_OUTOFMEMORY;
+
+        for (size_t j = 0; j < maxLive; ++j)
+        {
+            output.freeRows[j] = output.pool.get() + j * destImage.width;
         }
+        output.freeCount = maxLive;
 
         return S_OK;
     }
 
-
-    //--- Custom filter resize ---
-    HRESULT PerformResizeUsingCustomFilters(const Image& srcImage, TEX_FILTER_FLAGS filter, const Image& destImage) noexcept
+    HRESULT ResizeMultiSeparable(
+        const Image& srcImage,
+        TEX_FILTER_FLAGS filter,
+        _In_reads_(count) const Image* destImages,
+        size_t count) noexcept
     {
-        if (!srcImage.pixels || !destImage.pixels)
-            return E_POINTER;
+        assert(destImages != nullptr && count > 0);
 
-        static_assert(TEX_FILTER_POINT == 0x100000, "TEX_FILTER_ flag values don't match TEX_FILTER_MASK");
+        const unsigned long kernel = filter & TEX_FILTER_MODE_MASK;
 
-        unsigned long filter_select = filter & TEX_FILTER_MODE_MASK;
-        if (!filter_select)
+        std::unique_ptr<ResizeOutput[]> outputs(new (std::nothrow) ResizeOutput[count]);
+        if (!outputs)
+            return E_OUTOFMEMORY;
+
+        // Targets of the same width share their horizontal pass
+        std::unique_ptr<size_t[]> hrowWidth(new (std::nothrow) size_t[count]);
+        std::unique_ptr<XMVECTOR*[]> hrows(new (std::nothrow) XMVECTOR*[count]);
+        std::unique_ptr<bool[]> hrowNeeded(new (std::nothrow) bool[count]);
+        if (!hrowWidth || !hrows || !hrowNeeded)
+            return E_OUTOFMEMORY;
+
+        size_t hrowCount = 0;
+        uint64_t scanlines = srcImage.width;
+        for (size_t i = 0; i < count; ++i)
         {
-            // Default filter choice
-            filter_select = (((destImage.width << 1) == srcImage.width) && ((destImage.height << 1) == srcImage.height))
-                ? TEX_FILTER_BOX : TEX_FILTER_LINEAR;
+            HRESULT hr = SetupResizeOutput(srcImage, filter, kernel, destImages[i], outputs[i]);
+            if (FAILED(hr))
+                return hr;
+
+            size_t j = 0;
+            for (; j < hrowCount; ++j)
+            {
+                if (hrowWidth[j] == destImages[i].width)
+                    break;
+            }
+
+            if (j == hrowCount)
+            {
+                hrowWidth[hrowCount++] = destImages[i].width;
+                scanlines += destImages[i].width;
+            }
+
+            outputs[i].hrowIndex = j;
         }
 
-        switch (filter_select)
+        if (scanlines > (SIZE_MAX / sizeof(XMVECTOR)))
+            return HRESULT_FROM_WIN32(ERROR_ARITHMETIC_OVERFLOW);
+
+        // Allocate temporary space (1 source scanline, plus 1 filtered scanline per distinct width)
+        ScopedAlignedArrayXMVECTOR scanline(static_cast<XMVECTOR*>(_AlignedAlloc(sizeof(XMVECTOR) * static_cast<size_t>(scanlines), 16)));
+        if (!scanline)
+            return E_OUTOFMEMORY;
+
+        XMVECTOR* row = scanline.get();
+        XMVECTOR* next = row + srcImage.width;
+        for (size_t j = 0; j < hrowCount; ++j)
         {
-        case TEX_FILTER_POINT:
-            return ResizePointFilter(srcImage, destImage);
+            hrows[j] = next;
+            next += hrowWidth[j];
+        }
 
-        case TEX_FILTER_BOX:
-            return ResizeBoxFilter(srcImage, filter, destImage);
+        const uint8_t* pSrc = srcImage.pixels;
 
-        case TEX_FILTER_LINEAR:
-            return ResizeLinearFilter(srcImage, filter, destImage);
+        for (size_t v = 0; v < srcImage.height; ++v, pSrc += srcImage.rowPitch)
+        {
+            // Skip source rows that no target samples
+            memset(hrowNeeded.get(), 0, sizeof(bool) * hrowCount);
+            bool needed = false;
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (outputs[i].rowStart[v + 1] > outputs[i].rowStart[v])
+                {
+                    hrowNeeded[outputs[i].hrowIndex] = true;
+                    needed = true;
+                }
+            }
 
-        case TEX_FILTER_CUBIC:
-            return ResizeCubicFilter(srcImage, filter, destImage);
+            if (!needed)
+                continue;
 
-        case TEX_FILTER_TRIANGLE:
-            return ResizeTriangleFilter(srcImage, filter, destImage);
+            if (!_LoadScanlineLinear(row, srcImage.width, pSrc, srcImage.rowPitch, srcImage.format, filter))
+                return E_FAIL;
 
-        default:
-            return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+            // Horizontal pass, once per distinct width
+            for (size_t i = 0; i < count; ++i)
+            {
+                const size_t j = outputs[i].hrowIndex;
+                if (!hrowNeeded[j])
+                    continue;
+
+                hrowNeeded[j] = false;
+
+                const ResampleTable* tX = outputs[i].tX.get();
+                const size_t taps = tX->taps;
+                const uint32_t* ix = tX->index.get();
+                const float* wx = tX->weight.get();
+
+                XMVECTOR* hrow = hrows[j];
+                for (size_t x = 0; x < tX->dest; ++x, ix += taps, wx += taps)
+                {
+                    XMVECTOR acc = XMVectorZero();
+                    for (size_t t = 0; t < taps; ++t)
+                    {
+                        acc = XMVectorMultiplyAdd(row[ix[t]], XMVectorReplicate(wx[t]), acc);
+                    }
+                    hrow[x] = acc;
+                }
+            }
+
+            // Vertical pass, accumulating into every destination row this source row feeds
+            for (size_t i = 0; i < count; ++i)
+            {
+                ResizeOutput& output = outputs[i];
+                const Image& destImage = *output.dest;
+                const XMVECTOR* hrow = hrows[output.hrowIndex];
+
+                for (uint32_t e = output.rowStart[v]; e < output.rowStart[v + 1]; ++e)
+                {
+                    const size_t y = output.rowDest[e];
+                    const XMVECTOR weight = XMVectorReplicate(output.rowWeight[e]);
+
+                    XMVECTOR* acc = output.active[y];
+                    if (!acc)
+                    {
+                        if (!output.freeCount)
+                            return E_UNEXPECTED;
+
+                        acc = output.freeRows[--output.freeCount];
+                        output.active[y] = acc;
+
+                        for (size_t x = 0; x < destImage.width; ++x)
+                        {
+                            acc[x] = XMVectorMultiply(hrow[x], weight);
+                        }
+                    }
+                    else
+                    {
+                        for (size_t x = 0; x < destImage.width; ++x)
+                        {
+                            acc[x] = XMVectorMultiplyAdd(hrow[x], weight, acc[x]);
+                        }
+                    }
+
+                    assert(output.remaining[y] > 0);
+                    if (!--output.remaining[y])
+                    {
+                        // This performs any required clamping
+                        if (!_StoreScanlineLinear(destImage.pixels + (destImage.rowPitch * y), destImage.rowPitch, destImage.format, acc, destImage.width, filter))
+                            return E_FAIL;
+
+                        output.active[y] = nullptr;
+                        output.freeRows[output.freeCount++] = acc;
+                    }
+                }
+            }
         }
+
+        return S_OK;
     }
 }
 
-
 //=====================================================================================
 // Entry-points
 //=====================================================================================
@@ -864,6 +1886,13 @@ HRESULT DirectX::Resize(
 
     bool usewic = UseWICFiltering(srcImage.format, filter);
 
+    if (usewic && !(filter & TEX_FILTER_FORCE_WIC)
+        && UseIntegerRatioResize(srcImage.format, srcImage.width, srcImage.height, width, height, filter))
+    {
+        // Whole-factor box reductions are done directly on the integer channels
+        usewic = false;
+    }
+
     WICPixelFormatGUID pfGUID = {};
     bool wicpf = (usewic) ? _DXGIToWIC(srcImage.format, pfGUID, true) : false;
 
@@ -905,7 +1934,9 @@ HRESULT DirectX::Resize(
     else
     {
         // Case 3: not using WIC resizing
-        hr = PerformResizeUsingCustomFilters(srcImage, filter, *rimage);
+        hr = UseIntegerRatioResize(srcImage.format, srcImage.width, srcImage.height, width, height, filter)
+            ? ResizeIntegerRatio(srcImage, filter, *rimage)
+            : PerformResizeUsingCustomFilters(srcImage, filter, *rimage);
     }
 
     if (FAILED(hr))
@@ -918,6 +1949,123 @@ HRESULT DirectX::Resize(
 }
 
 
+//-------------------------------------------------------------------------------------
+// Resize image to several sizes in one pass over the source
+//-------------------------------------------------------------------------------------
+_Use_decl_annotations_
+HRESULT DirectX::Resize(
+    const Image& srcImage,
+    const size_t* widths,
+    const size_t* heights,
+    size_t count,
+    TEX_FILTER_FLAGS filter,
+    ScratchImage* images) noexcept
+{
+    if (!widths || !heights || !count || !images)
+        return E_INVALIDARG;
+
+    if ((srcImage.width > UINT32_MAX) || (srcImage.height > UINT32_MAX))
+        return E_INVALIDARG;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (widths[i] == 0 || heights[i] == 0)
+            return E_INVALIDARG;
+
+        if ((widths[i] > UINT32_MAX) || (heights[i] > UINT32_MAX))
+            return E_INVALIDARG;
+    }
+
+    if (!srcImage.pixels)
+        return E_POINTER;
+
+    if (IsCompressed(srcImage.format))
+    {
+        // We don't support resizing compressed images
+        return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+    }
+
+    static_assert(TEX_FILTER_POINT == 0x100000, "TEX_FILTER_ flag values don't match TEX_FILTER_MODE_MASK");
+
+    bool shared = !(filter & TEX_FILTER_FORCE_WIC);
+    switch (filter & TEX_FILTER_MODE_MASK)
+    {
+    case 0:
+        // Default to an area average, which matches Box for exact halving
+        if (shared)
+        {
+            filter = static_cast<TEX_FILTER_FLAGS>(filter | TEX_FILTER_BOX);
+        }
+        break;
+
+    case TEX_FILTER_BOX:
+    case TEX_FILTER_TRIANGLE:
+    case TEX_FILTER_LANCZOS:
+    case TEX_FILTER_MITCHELL:
+    case TEX_FILTER_KAISER:
+        break;
+
+    default:
+        shared = false;
+        break;
+    }
+
+    if (!shared)
+    {
+        // Other filters do not run as separable kernels, so resize to each size in turn
+        for (size_t i = 0; i < count; ++i)
+        {
+            HRESULT hr = Resize(srcImage, widths[i], heights[i], filter, images[i]);
+            if (FAILED(hr))
+            {
+                for (size_t j = 0; j < i; ++j)
+                {
+                    images[j].Release();
+                }
+                return hr;
+            }
+        }
+        return S_OK;
+    }
+
+    std::unique_ptr<Image[]> dest(new (std::nothrow) Image[count]);
+    if (!dest)
+        return E_OUTOFMEMORY;
+
+    HRESULT hr = S_OK;
+    for (size_t i = 0; i < count; ++i)
+    {
+        hr = images[i].Initialize2D(srcImage.format, widths[i], heights[i], 1, 1);
+        if (FAILED(hr))
+            break;
+
+        const Image *rimage = images[i].GetImage(0, 0, 0);
+        if (!rimage)
+        {
+            hr = E_POINTER;
+            break;
+        }
+
+        dest[i] = *rimage;
+    }
+
+    if (SUCCEEDED(hr))
+    {
+        hr = ResizeMultiSeparable(srcImage, filter, dest.get(), count);
+    }
+
+    if (FAILED(hr))
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            images[i].Release();
+        }
+        return hr;
+    }
+
+    return S_OK;
+}
+
 //-------------------------------------------------------------------------------------
 // Resize image (complex)
 //-------------------------------------------------------------------------------------
@@ -947,6 +2095,13 @@ HRESULT DirectX::Resize(
 
     bool usewic = !metadata.IsPMAlpha() && UseWICFiltering(metadata.format, filter);
 
+    if (usewic && !(filter & TEX_FILTER_FORCE_WIC)
+        && UseIntegerRatioResize(metadata.format, metadata.width, metadata.height, width, height, filter))
+    {
+        // Whole-factor box reductions are done directly on the integer channels
+        usewic = false;
+    }
+
     WICPixelFormatGUID pfGUID = {};
     bool wicpf = (usewic) ? _DXGIToWIC(metadata.format, pfGUID, true) : false;
 
@@ -1015,7 +2170,9 @@ HRESULT DirectX::Resize(
             else
             {
                 // Case 3: not using WIC resizing
-                hr = PerformResizeUsingCustomFilters(*srcimg, filter, *destimg);
+                hr = UseIntegerRatioResize(srcimg->format, srcimg->width, srcimg->height, width, height, filter)
+                    ? ResizeIntegerRatio(*srcimg, filter, *destimg)
+                    : PerformResizeUsingCustomFilters(*srcimg, filter, *destimg);
             }
 
             if (FAILED(hr))
@@ -1074,7 +2231,9 @@ HRESULT DirectX::Resize(
             else
             {
                 // Case 3: not using WIC resizing
-                hr = PerformResizeUsingCustomFilters(*srcimg, filter, *destimg);
+                hr = UseIntegerRatioResize(srcimg->format, srcimg->width, srcimg->height, width, height, filter)
+                    ? ResizeIntegerRatio(*srcimg, filter, *destimg)
+                    : PerformResizeUsingCustomFilters(*srcimg, filter, *destimg);
             }
 
             if (FAILED(hr))
@@ -1433,6 +1433,397 @@ size_t TexMetadata::ComputeIndex(size_t mip, size_t item, size_t slice) const no
 }
 
 
+//=====================================================================================
+// Memory allocation
+//=====================================================================================
+
+namespace
+{
+    // Stored immediately ahead of every pointer returned by _AlignedAlloc
+    struct AllocationHeader
+    {
+        IAllocator* allocator;
+        size_t      size;
+        size_t      alignment;
+    };
+
+    inline size_t AllocationPrefix(size_t alignment) noexcept
+    {
+        return (sizeof(AllocationHeader) + alignment - 1) & ~(alignment - 1);
+    }
+
+    class CrtAllocator final : public IAllocator
+    {
+    public:
+        void* __cdecl Allocate(size_t size, size_t alignment) noexcept override
+        {
+            return _aligned_malloc(size, alignment);
+        }
+
+        void __cdecl Free(void* ptr, size_t, size_t) noexcept override
+        {
+            _aligned_free(ptr);
+        }
+    };
+
+    CrtAllocator g_crtAllocator;
+
+    IAllocator* volatile g_defaultAllocator = &g_crtAllocator;
+
+    //-------------------------------------------------------------------------------------
+    // Size-class pool
+    //-------------------------------------------------------------------------------------
+    constexpr size_t POOL_ALIGNMENT = 64;
+        // Alignment of every pooled block; larger requests bypass the pool
+
+    constexpr size_t POOL_MIN_BLOCK = 64;
+    constexpr size_t POOL_SIZE_CLASSES = 26;
+        // 64 bytes to 2 GB in power-of-two steps; larger requests bypass the pool
+
+    constexpr size_t POOL_DEFAULT_CACHE = 256 * 1024 * 1024;
+
+    class PoolAllocator final : public IAllocator
+    {
+    public:
+        explicit PoolAllocator(size_t maxCachedBytes) noexcept :
+            m_lock{},
+            m_cachedBytes(0),
+            m_maxCachedBytes(maxCachedBytes ? maxCachedBytes : POOL_DEFAULT_CACHE),
+            m_free{}
+        {
+            InitializeSRWLock(&m_lock);
+        }
+
+        PoolAllocator(PoolAllocator const&) = delete;
+        PoolAllocator& operator=(PoolAllocator const&) = delete;
+
+        ~PoolAllocator() override
+        {
+            for (auto& it : m_free)
+            {
+                while (it)
+                {
+                    PoolBlock* next = it->next;
+                    _aligned_free(it);
+                    it = next;
+                }
+            }
+        }
+
+        void* __cdecl Allocate(size_t size, size_t alignment) noexcept override
+        {
+            const size_t sizeClass = SizeClass(size);
+            if (alignment > POOL_ALIGNMENT || sizeClass >= POOL_SIZE_CLASSES)
+                return _aligned_malloc(size, alignment);
+
+            AcquireSRWLockExclusive(&m_lock);
+            PoolBlock* block = m_free[sizeClass];
+            if (block)
+            {
+                m_free[sizeClass] = block->next;
+                m_cachedBytes -= POOL_MIN_BLOCK << sizeClass;
+            }
+            ReleaseSRWLockExclusive(&m_lock);
+
+            if (block)
+                return block;
+
+            return _aligned_malloc(POOL_MIN_BLOCK << sizeClass, POOL_ALIGNMENT);
+        }
+
+        void __cdecl Free(void* ptr, size_t size, size_t alignment) noexcept override
+        {
+            if (!ptr)
+                return;
+
+            const size_t sizeClass = SizeClass(size);
+            if (alignment > POOL_ALIGNMENT || sizeClass >= POOL_SIZE_CLASSES)
+            {
+                _aligned_free(ptr);
+                return;
+            }
+
+            const size_t bytes = POOL_MIN_BLOCK << sizeClass;
+
+            bool cached = false;
+            AcquireSRWLockExclusive(&m_lock);
+            if (bytes <= m_maxCachedBytes - m_cachedBytes)
+            {
+                auto block = static_cast<PoolBlock*>(ptr);
+                block->next = m_free[sizeClass];
+                m_free[sizeClass] = block;
+                m_cachedBytes += bytes;
+                cached = true;
+            }
+            ReleaseSRWLockExclusive(&m_lock);
+
+            if (!cached)
+                _aligned_free(ptr);
+        }
+
+    private:
+        struct PoolBlock
+        {
+            PoolBlock* next;
+        };
+
+        static size_t SizeClass(size_t size) noexcept
+        {
+            size_t sizeClass = 0;
+            while (sizeClass < POOL_SIZE_CLASSES && (POOL_MIN_BLOCK << sizeClass) < size)
+                ++sizeClass;
+            return sizeClass;
+        }
+
+        SRWLOCK     m_lock;
+        size_t      m_cachedBytes;
+        size_t      m_maxCachedBytes;
+        PoolBlock*  m_free[POOL_SIZE_CLASSES];
+    };
+
+    //-------------------------------------------------------------------------------------
+    // Per-job arena
+    //-------------------------------------------------------------------------------------
+    constexpr size_t ARENA_DEFAULT_BLOCK = 64 * 1024 * 1024;
+
+    class ArenaAllocator final : public IAllocator
+    {
+    public:
+        explicit ArenaAllocator(size_t blockSize) noexcept :
+            m_lock{},
+            m_blockSize(blockSize ? blockSize : ARENA_DEFAULT_BLOCK),
+            m_head(nullptr)
+        {
+            InitializeSRWLock(&m_lock);
+        }
+
+        ArenaAllocator(ArenaAllocator const&) = delete;
+        ArenaAllocator& operator=(ArenaAllocator const&) = delete;
+
+        ~ArenaAllocator() override
+        {
+            while (m_head)
+            {
+                ArenaBlock* next = m_head->next;
+                _aligned_free(m_head);
+                m_head = next;
+            }
+        }
+
+        void* __cdecl Allocate(size_t size, size_t alignment) noexcept override
+        {
+            if (size > SIZE_MAX - sizeof(ArenaBlock) - alignment)
+                return nullptr;
+
+            AcquireSRWLockExclusive(&m_lock);
+
+            void* ptr = (m_head) ? Carve(m_head, size, alignment) : nullptr;
+            if (!ptr)
+            {
+                // Oversized requests get a dedicated chunk linked behind the current one so it keeps serving
+                const size_t required = sizeof(ArenaBlock) + alignment + size;
+                const size_t bytes = std::max(required, m_blockSize);
+
+                auto block = static_cast<ArenaBlock*>(_aligned_malloc(bytes, 16));
+                if (block)
+                {
+                    block->size = bytes;
+                    block->used = sizeof(ArenaBlock);
+                    ptr = Carve(block, size, alignment);
+
+                    if (m_head && bytes > m_blockSize)
+                    {
+                        block->next = m_head->next;
+                        m_head->next = block;
+                    }
+                    else
+                    {
+                        block->next = m_head;
+                        m_head = block;
+                    }
+                }
+            }
+
+            ReleaseSRWLockExclusive(&m_lock);
+
+            return ptr;
+        }
+
+        void __cdecl Free(void*, size_t, size_t) noexcept override
+        {
+            // Memory is reclaimed when the arena is destroyed
+        }
+
+    private:
+        struct ArenaBlock
+        {
+            ArenaBlock* next;
+            size_t      size;
+            size_t      used;
+        };
+
+        static void* Carve(ArenaBlock* block, size_t size, size_t alignment) noexcept
+        {
+            const uintptr_t base = reinterpret_cast<uintptr_t>(block);
+            const uintptr_t ptr = (base + block->used + alignment - 1) & ~static_cast<uintptr_t>(alignment - 1);
+            const size_t offset = static_cast<size_t>(ptr - base);
+            if (offset > block->size || size > block->size - offset)
+                return nullptr;
+
+            block->used = offset + size;
+            return reinterpret_cast<void*>(ptr);
+        }
+
+        SRWLOCK     m_lock;
+        size_t      m_blockSize;
+        ArenaBlock* m_head;
+    };
+
+    //-------------------------------------------------------------------------------------
+    // Large-page allocator
+    //-------------------------------------------------------------------------------------
+    constexpr size_t LARGE_PAGE_DEFAULT_THRESHOLD = 2 * 1024 * 1024;
+
+    constexpr size_t LARGE_PAGE_MAX_ALIGNMENT = 4096;
+        // VirtualAlloc returns at least page-aligned memory
+
+    class LargePageAllocator final : public IAllocator
+    {
+    public:
+        explicit LargePageAllocator(size_t threshold) noexcept :
+            m_threshold(threshold ? threshold : LARGE_PAGE_DEFAULT_THRESHOLD),
+            m_largePage(0)
+        {
+        #if !defined(WINAPI_FAMILY) || (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+            m_largePage = GetLargePageMinimum();
+        #endif
+        }
+
+        void* __cdecl Allocate(size_t size, size_t alignment) noexcept override
+        {
+            if (!UseVirtualAlloc(size, alignment))
+                return _aligned_malloc(size, alignment);
+
+        #if !defined(WINAPI_FAMILY) || (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+            if (m_largePage && size <= SIZE_MAX - m_largePage)
+            {
+                // Fails without SeLockMemoryPrivilege or when physical memory is too fragmented
+                const size_t bytes = (size + m_largePage - 1) & ~(m_largePage - 1);
+                void* ptr = VirtualAlloc(nullptr, bytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+                if (ptr)
+                    return ptr;
+            }
+
+            return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        #else
+            return _aligned_malloc(size, alignment);
+        #endif
+        }
+
+        void __cdecl Free(void* ptr, size_t size, size_t alignment) noexcept override
+        {
+            if (!ptr)
+                return;
+
+        #if !defined(WINAPI_FAMILY) || (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+            if (UseVirtualAlloc(size, alignment))
+            {
+                (void)VirtualFree(ptr, 0, MEM_RELEASE);
+                return;
+            }
+        #else
+            UNREFERENCED_PARAMETER(size);
+            UNREFERENCED_PARAMETER(alignment);
+        #endif
+
+            _aligned_free(ptr);
+        }
+
+    private:
+        bool UseVirtualAlloc(size_t size, size_t alignment) const noexcept
+        {
+            return (size >= m_threshold) && (alignment <= LARGE_PAGE_MAX_ALIGNMENT);
+        }
+
+        size_t  m_threshold;
+        size_t  m_largePage;
+    };
+}
+
+IAllocator* DirectX::GetDefaultAllocator() noexcept
+{
+    return g_defaultAllocator;
+}
+
+_Use_decl_annotations_
+IAllocator* DirectX::SetDefaultAllocator(IAllocator* allocator) noexcept
+{
+    if (!allocator)
+        allocator = &g_crtAllocator;
+
+    return static_cast<IAllocator*>(InterlockedExchangePointer(
+        reinterpret_cast<PVOID volatile*>(&g_defaultAllocator), allocator));
+}
+
+_Use_decl_annotations_
+std::unique_ptr<IAllocator> DirectX::CreatePoolAllocator(size_t maxCachedBytes) noexcept
+{
+    return std::unique_ptr<IAllocator>(new (std::nothrow) PoolAllocator(maxCachedBytes));
+}
+
+_Use_decl_annotations_
+std::unique_ptr<IAllocator> DirectX::CreateArenaAllocator(size_t blockSize) noexcept
+{
+    return std::unique_ptr<IAllocator>(new (std::nothrow) ArenaAllocator(blockSize));
+}
+
+_Use_decl_annotations_
+std::unique_ptr<IAllocator> DirectX::CreateLargePageAllocator(size_t threshold) noexcept
+{
+    return std::unique_ptr<IAllocator>(new (std::nothrow) LargePageAllocator(threshold));
+}
+
+_Use_decl_annotations_
+void* DirectX::_AlignedAlloc(size_t size, size_t alignment, IAllocator* allocator) noexcept
+{
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+    if (!allocator)
+        allocator = GetDefaultAllocator();
+
+    alignment = std::max<size_t>(alignment, 16);
+
+    const size_t prefix = AllocationPrefix(alignment);
+    if (size > SIZE_MAX - prefix)
+        return nullptr;
+
+    auto base = static_cast<uint8_t*>(allocator->Allocate(size + prefix, alignment));
+    if (!base)
+        return nullptr;
+
+    auto header = reinterpret_cast<AllocationHeader*>(base + prefix) - 1;
+    header->allocator = allocator;
+    header->size = size + prefix;
+    header->alignment = alignment;
+
+    return base + prefix;
+}
+
+_Use_decl_annotations_
+void DirectX::_AlignedFree(void* ptr) noexcept
+{
+    if (!ptr)
+        return;
+
+    auto header = static_cast<AllocationHeader*>(ptr) - 1;
+    IAllocator* allocator = header->allocator;
+    const size_t size = header->size;
+    const size_t alignment = header->alignment;
+
+    allocator->Free(static_cast<uint8_t*>(ptr) - AllocationPrefix(alignment), size, alignment);
+}
+
+
 //=====================================================================================
 // Blob - Bitmap image container
 //=====================================================================================
@@ -1445,6 +1836,7 @@ Blob& Blob::operator= (Blob&& moveFrom) noexcept
 
         m_buffer = moveFrom.m_buffer;
         m_size = moveFrom.m_size;
+        m_allocator = moveFrom.m_allocator;
 
         moveFrom.m_buffer = nullptr;
         moveFrom.m_size = 0;
@@ -1456,7 +1848,7 @@ void Blob::Release() noexcept
 {
     if (m_buffer)
     {
-        _aligned_free(m_buffer);
+        _AlignedFree(m_buffer);
         m_buffer = nullptr;
     }
 
@@ -1471,7 +1863,7 @@ HRESULT Blob::Initialize(size_t size) noexcept
 
     Release();
 
-    m_buffer = _aligned_malloc(size, 16);
+    m_buffer = _AlignedAlloc(size, 16, m_allocator);
     if (!m_buffer)
     {
         Release();
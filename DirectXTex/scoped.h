@@ -14,7 +14,9 @@
 #include <malloc.h>
 
 //---------------------------------------------------------------------------------
-struct aligned_deleter { void operator()(void* p) noexcept { _aligned_free(p); } };
+namespace DirectX { void __cdecl _AlignedFree(_In_opt_ void* ptr) noexcept; }
+
+struct aligned_deleter { void operator()(void* p) noexcept { DirectX::_AlignedFree(p); } };
 
 using ScopedAlignedArrayFloat = std::unique_ptr<float[], aligned_deleter>;
 
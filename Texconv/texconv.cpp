@@ -1680,6 +1680,9 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
     bool preserveAlphaCoverage = false;
     ComPtr<ID3D11Device> pDevice;
 
+    // Buffer retired by the previous stage, recycled as the next stage's output
+    std::unique_ptr<ScratchImage> spare;
+
     for (auto pConv = conversion.begin(); pConv != conversion.end(); ++pConv)
     {
         if (pConv != conversion.begin())
@@ -1832,7 +1835,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(img);
             size_t nimg = image->GetImageCount();
 
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -1859,6 +1862,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
         }
 
         DXGI_FORMAT tformat = (format == DXGI_FORMAT_UNKNOWN) ? info.format : format;
@@ -1872,7 +1876,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             {
                 if (dwOptions & (DWORD64(1) << OPT_BCNONMULT4FIX))
                 {
-                    std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+                    std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
                     if (!timage)
                     {
                         wprintf(L"\nERROR: Memory allocation failed\n");
@@ -1922,6 +1926,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                     info.height = mdata.height;
                     info.mipLevels = mdata.mipLevels;
                     image.swap(timage);
+                    spare = std::move(timage);
                 }
                 else if (IsCompressed(tformat))
                 {
@@ -1933,7 +1938,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(img);
             size_t nimg = image->GetImageCount();
 
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -1968,6 +1973,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             else
             {
                 image.swap(timage);
+                spare = std::move(timage);
             }
         }
 
@@ -1990,7 +1996,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 assert(img);
                 size_t nimg = image->GetImageCount();
 
-                std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+                std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
                 if (!timage)
                 {
                     wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2016,6 +2022,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 assert(info.dimension == tinfo.dimension);
 
                 image.swap(timage);
+                spare = std::move(timage);
                 cimage.reset();
             }
         }
@@ -2023,7 +2030,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
         // --- Flip/Rotate -------------------------------------------------------------
         if (dwOptions & ((DWORD64(1) << OPT_HFLIP) | (DWORD64(1) << OPT_VFLIP)))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2060,6 +2067,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
@@ -2089,7 +2097,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
 
         if (info.width != twidth || info.height != theight)
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2117,6 +2125,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
@@ -2125,7 +2134,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
         {
             if (dwRotateColor == ROTATE_HDR10_TO_709)
             {
-                std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+                std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
                 if (!timage)
                 {
                     wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2156,10 +2165,11 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 assert(info.dimension == tinfo.dimension);
 
                 image.swap(timage);
+                spare = std::move(timage);
                 cimage.reset();
             }
 
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2348,13 +2358,14 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
         // --- Tonemap (if requested) --------------------------------------------------
         if (dwOptions & DWORD64(1) << OPT_TONEMAP)
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2428,13 +2439,14 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
         // --- Convert -----------------------------------------------------------------
         if (dwOptions & (DWORD64(1) << OPT_NORMAL_MAP))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2483,11 +2495,12 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
         else if (info.format != tformat && !IsCompressed(tformat))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2516,6 +2529,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
@@ -2523,7 +2537,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
         if ((dwOptions & (DWORD64(1) << OPT_COLORKEY))
             && HasAlpha(info.format))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2575,13 +2589,14 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
         // --- Invert Y Channel --------------------------------------------------------
         if (dwOptions & (DWORD64(1) << OPT_INVERT_Y))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2624,13 +2639,14 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
         // --- Reconstruct Z Channel ---------------------------------------------------
         if (dwOptions & (DWORD64(1) << OPT_RECONSTRUCT_Z))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2673,6 +2689,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
@@ -2703,7 +2720,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             // Mips generation only works on a single base image, so strip off existing mip levels
             // Also required for preserve alpha coverage so that existing mips are regenerated
 
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2788,11 +2805,13 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             {
                 cimage.reset();
             }
+
+            spare = std::move(timage);
         }
 
         if ((!tMips || info.mipLevels != tMips) && (info.width > 1 || info.height > 1 || info.depth > 1))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2825,13 +2844,14 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
         // --- Preserve mipmap alpha coverage (if requested) ---------------------------
         if (preserveAlphaCoverage && info.mipLevels != 1 && (info.dimension != TEX_DIMENSION_TEXTURE3D))
         {
-            std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+            std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
             if (!timage)
             {
                 wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2872,6 +2892,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             assert(info.dimension == tinfo.dimension);
 
             image.swap(timage);
+            spare = std::move(timage);
             cimage.reset();
         }
 
@@ -2890,7 +2911,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 assert(img);
                 size_t nimg = image->GetImageCount();
 
-                std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+                std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
                 if (!timage)
                 {
                     wprintf(L"\nERROR: Memory allocation failed\n");
@@ -2916,6 +2937,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 assert(info.dimension == tinfo.dimension);
 
                 image.swap(timage);
+                spare = std::move(timage);
                 cimage.reset();
             }
         }
@@ -2952,7 +2974,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 assert(img);
                 size_t nimg = image->GetImageCount();
 
-                std::unique_ptr<ScratchImage> timage(new (std::nothrow) ScratchImage);
+                std::unique_ptr<ScratchImage> timage(spare ? spare.release() : new (std::nothrow) ScratchImage);
                 if (!timage)
                 {
                     wprintf(L"\nERROR: Memory allocation failed\n");
@@ -3033,6 +3055,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 assert(info.dimension == tinfo.dimension);
 
                 image.swap(timage);
+                spare = std::move(timage);
             }
         }
         else
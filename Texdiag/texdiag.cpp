@@ -54,6 +54,7 @@ enum COMMANDS
     CMD_DIFF,
     CMD_DUMPBC,
     CMD_DUMPDDS,
+    CMD_SCAN,
     CMD_MAX
 };
 
@@ -75,6 +76,7 @@ enum OPTIONS
     OPT_TARGET_PIXELX,
     OPT_TARGET_PIXELY,
     OPT_FILELIST,
+    OPT_CATALOG,
     OPT_MAX
 };
 
@@ -103,6 +105,7 @@ const SValue g_pCommands[] =
     { L"diff",      CMD_DIFF },
     { L"dumpbc",    CMD_DUMPBC },
     { L"dumpdds",   CMD_DUMPDDS },
+    { L"scan",      CMD_SCAN },
     { nullptr,      0 }
 };
 
@@ -124,6 +127,7 @@ const SValue g_pOptions[] =
     { L"targetx",   OPT_TARGET_PIXELX },
     { L"targety",   OPT_TARGET_PIXELY },
     { L"flist",     OPT_FILELIST },
+    { L"catalog",   OPT_CATALOG },
     { nullptr,      0 }
 };
 
@@ -567,7 +571,8 @@ namespace
         wprintf(L"   compare             Compare two images with MSE error metric\n");
         wprintf(L"   diff                Generate difference image from two images\n");
         wprintf(L"   dumpbc              Dump out compressed blocks (DDS BC only)\n");
-        wprintf(L"   dumpdds             Dump out all the images in a complex DDS\n\n");
+        wprintf(L"   dumpdds             Dump out all the images in a complex DDS\n");
+        wprintf(L"   scan                Output header metadata of many DDS, TGA, or HDR files at once\n\n");
         wprintf(L"   -r                  wildcard filename search is recursive\n");
         wprintf(L"   -if <filter>        image filtering\n");
         wprintf(L"\n                       (DDS input only)\n");
@@ -585,6 +590,8 @@ namespace
         wprintf(L"   -targety <num>      dump pixels at location y (defaults to all)\n");
         wprintf(L"\n                       (dumpdds only)\n");
         wprintf(L"   -ft <filetype>      output file type\n");
+        wprintf(L"\n                       (scan only)\n");
+        wprintf(L"   -catalog <filename> reuse metadata of unchanged files from a catalog file (updated as needed)\n");
         wprintf(L"\n   -nologo             suppress copyright message\n");
         wprintf(L"   -flist <filename>   use text file with a list of input files (one per line)\n");
 
@@ -3079,6 +3086,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
     DXGI_FORMAT diffFormat = DXGI_FORMAT_B8G8R8A8_UNORM;
     DWORD fileType = WIC_CODEC_BMP;
     wchar_t szOutputFile[MAX_PATH] = {};
+    wchar_t szCatalog[MAX_PATH] = {};
 
     // Initialize COM (needed for WIC)
     HRESULT hr = hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
@@ -3104,10 +3112,11 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
     case CMD_DIFF:
     case CMD_DUMPBC:
     case CMD_DUMPDDS:
+    case CMD_SCAN:
         break;
 
     default:
-        wprintf(L"Must use one of: info, analyze, compare, diff, dumpbc, or dumpdds\n\n");
+        wprintf(L"Must use one of: info, analyze, compare, diff, dumpbc, dumpdds, or scan\n\n");
         return 1;
     }
 
@@ -3148,6 +3157,7 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
             case OPT_TARGET_PIXELX:
             case OPT_TARGET_PIXELY:
             case OPT_FILELIST:
+            case OPT_CATALOG:
                 if (!*pValue)
                 {
                     if ((iArg + 1 >= argc))
@@ -3259,6 +3269,18 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
                 }
                 break;
 
+            case OPT_CATALOG:
+                if (dwCommand != CMD_SCAN)
+                {
+                    wprintf(L"-catalog only valid for use with scan command\n");
+                    return 1;
+                }
+                else
+                {
+                    wcscpy_s(szCatalog, MAX_PATH, pValue);
+                }
+                break;
+
             case OPT_FILELIST:
             {
                 std::wifstream inFile(pValue);
@@ -3593,6 +3615,91 @@ int __cdecl wmain(_In_ int argc, _In_z_count_(argc) wchar_t* argv[])
         }
         break;
 
+    case CMD_SCAN:
+        // --- Scan --------------------------------------------------------------------
+        {
+            DDS_FLAGS ddsFlags = DDS_FLAGS_ALLOW_LARGE_FILES;
+            if (dwOptions & (1 << OPT_DDS_DWORD_ALIGN))
+                ddsFlags |= DDS_FLAGS_LEGACY_DWORD;
+            if (dwOptions & (1 << OPT_EXPAND_LUMINANCE))
+                ddsFlags |= DDS_FLAGS_EXPAND_LUMINANCE;
+            if (dwOptions & (1 << OPT_DDS_BAD_DXTN_TAILS))
+                ddsFlags |= DDS_FLAGS_BAD_DXTN_TAILS;
+
+            std::vector<const wchar_t*> files;
+            files.reserve(conversion.size());
+            for (auto pConv = conversion.cbegin(); pConv != conversion.cend(); ++pConv)
+            {
+                files.push_back(pConv->szSrc);
+            }
+
+            std::vector<TexMetadata> infos(files.size());
+            std::vector<HRESULT> results(files.size());
+
+            hr = GetMetadataFromFiles(files.data(), files.size(), ddsFlags, TGA_FLAGS_NONE,
+                infos.data(), results.data(), (*szCatalog) ? szCatalog : nullptr);
+            if (FAILED(hr))
+            {
+                wprintf(L"ERROR: Scan failed (%x)\n", static_cast<unsigned int>(hr));
+                return 1;
+            }
+
+            size_t failed = 0;
+            for (size_t j = 0; j < files.size(); ++j)
+            {
+                wprintf(L"%ls", files[j]);
+
+                if (FAILED(results[j]))
+                {
+                    wprintf(L": FAILED (%x)\n", static_cast<unsigned int>(results[j]));
+                    ++failed;
+                    continue;
+                }
+
+                const TexMetadata& info = infos[j];
+                wprintf(L": %zu x %zu x %zu, %zu mips, %zu items, ", info.width, info.height, info.depth, info.mipLevels, info.arraySize);
+                PrintFormat(info.format);
+
+                switch (info.dimension)
+                {
+                case TEX_DIMENSION_TEXTURE1D:
+                    wprintf(L", %ls\n", (info.arraySize > 1) ? L"1DArray" : L"1D");
+                    break;
+
+                case TEX_DIMENSION_TEXTURE2D:
+                    if (info.IsCubemap())
+                    {
+                        wprintf(L", %ls\n", (info.arraySize > 6) ? L"CubeArray" : L"Cube");
+                    }
+                    else
+                    {
+                        wprintf(L", %ls\n", (info.arraySize > 1) ? L"2DArray" : L"2D");
+                    }
+                    break;
+
+                case TEX_DIMENSION_TEXTURE3D:
+                    wprintf(L", 3D\n");
+                    break;
+
+                default:
+                    wprintf(L"\n");
+                    break;
+                }
+            }
+
+            if (hr == S_FALSE)
+            {
+                wprintf(L"\nWARNING: Catalog '%ls' could not be updated\n", szCatalog);
+            }
+
+            if (failed > 0)
+            {
+                wprintf(L"\n%zu of %zu files failed\n", failed, files.size());
+                return 1;
+            }
+        }
+        break;
+
     default:
         for (auto pConv = conversion.cbegin(); pConv != conversion.cend(); ++pConv)
         {